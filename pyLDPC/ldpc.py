@@ -16,7 +16,13 @@ class sim_results_t(ct.Structure):
 class decoder_param(ct.Structure):
     _fields_ = [("earlyTerm", ct.c_bool),
                 ("iterations", ct.c_uint32),
-                ("type", ct.c_char_p)]
+                ("type", ct.c_char_p),
+                ("blockIterations", ct.c_uint32),
+                ("crcPoly", ct.c_uint64),
+                ("weightFile", ct.c_char_p),
+                ("tableFile", ct.c_char_p),
+                ("warmStart", ct.c_bool),
+                ("msOffset", ct.c_double)]
 
 class channel_param(ct.Structure):
     _fields_ = [("seed", ct.c_uint64),
@@ -27,7 +33,18 @@ class simulation_param(ct.Structure):
     _fields_ = [("threads", ct.c_uint32),
                 ("maxFrames", ct.c_uint64),
                 ("fec", ct.c_uint64),
-                ("resultFile", ct.c_char_p)]
+                ("resultFile", ct.c_char_p),
+                ("transmissions", ct.c_uint32)]
+
+class de_param(ct.Structure):
+    _fields_ = [("method", ct.c_char_p),
+                ("decoding", ct.c_char_p),
+                ("channel", ct.c_char_p),
+                ("iterations", ct.c_uint32),
+                ("bins", ct.c_uint32),
+                ("maxLlr", ct.c_double),
+                ("targetError", ct.c_double),
+                ("tolerance", ct.c_double)]
 
 class LDPC:
     def __init__(self, pc_file: str, gen_file = "", lib = LIB_PATH):    
@@ -69,43 +86,49 @@ class LDPC:
             "earlyTerm": True,
             "iterations": 50,
             "decoding": "BP",
+            "blockIterations": 0,
+            "crcPoly": 0,
+            "weightFile": "",
+            "tableFile": "",
+            "warmStart": False,
+            "msOffset": 0.5,
             "seed": 0,
             "snr": [],
             "channel": "AWGN",
             "threads": 1,
             "maxFrames": int(10e9),
-            "fec": 50
+            "fec": 50,
+            "transmissions": 1
         }
 
 
     def encode(self, info_word: np.array) -> np.array:
-        """Encode a binary array.
+        """Encode a binary array. Without a generator matrix, the codeword
+        is encoded from the parity-check matrix.
 
         Args:
             info_word (np.array): Input binary array.
 
         Raises:
-            RuntimeError: No generator matrix is initially provided.
+            RuntimeError: Neither G is provided nor can H be used for encoding.
 
         Returns:
             np.array: Encoded binary codeword.
         """
-        if not self.gen_file:
-            raise RuntimeError("No generator matrix provided for encoding")
-
         vec_in = ct.c_uint8 * self.kct
         vec_out = ct.c_uint8 * self.nct
         in_arr = vec_in(*info_word)
         out_arr = vec_out()
 
         self.lib.argtypes = (vec_in, vec_out)
-        self.lib.encode(ct.byref(in_arr), ct.byref(out_arr))
+        if self.lib.encode(ct.byref(in_arr), ct.byref(out_arr)) != 0:
+            raise RuntimeError("No encoder available, provide a generator matrix")
 
         return np.array(out_arr[0:self.nct])
 
 
 
-    def decode(self, llr_in: np.array, early_term=True, iters=50, dec_type="BP") -> np.array:
+    def decode(self, llr_in: np.array, early_term=True, iters=50, dec_type="BP", block_iters=0, crc_poly=0, weight_file="", table_file="", warm_start=False, ms_offset=0.5) -> np.array:
         """Decode array of input LLRs.
 
         Args:
@@ -113,13 +136,25 @@ class LDPC:
             early_term (bool, optional): Terminate decoding if codeword 
             is valid. Defaults to True.
             iters (int, optional): Number of iterations. Defaults to 50.
-            dec_type (str, optional): Type of decoding. See libldpc documentation
-            Defaults to "BP".
+            dec_type (str, optional): Type of decoding or a cascade of types,
+            e.g. "BF,BP_OMS,BP". See libldpc documentation. Defaults to "BP".
+            block_iters (int, optional): Local iterations per cache-sized 
+            layer, 0 for flooding schedule. Defaults to 0.
+            crc_poly (int, optional): CRC polynomial over the information bits
+            for early termination, 0 to disable. Defaults to 0.
+            weight_file (str, optional): CN weight file for weighted min-sum 
+            ("BP_WMS"). Defaults to "".
+            table_file (str, optional): Table file for lookup-table decoding 
+            ("LUT"). Defaults to "".
+            warm_start (bool, optional): Cascaded decoding resumes from the 
+            messages of the previous stage. Defaults to False.
+            ms_offset (float, optional): Offset for offset min-sum ("BP_OMS").
+            Defaults to 0.5.
 
         Returns:
             np.array: Output LLR, length n (transmitted)
         """
-        dec_params = decoder_param(early_term, iters, dec_type.encode("utf-8"))
+        dec_params = decoder_param(early_term, iters, dec_type.encode("utf-8"), block_iters, crc_poly, weight_file.encode("utf-8"), table_file.encode("utf-8"), warm_start, ms_offset)
 
         vec_double = ct.c_double * self.nct
         in_arr = vec_double(*llr_in)
@@ -132,26 +167,57 @@ class LDPC:
         return np.array(out_arr[0:self.nct]), iter_req
 
 
+    def resume(self, llr_in: np.array) -> np.array:
+        """Combine the LLRs of a further transmission with the state of the
+        last decoding and resume decoding (IR-HARQ).
+
+        Args:
+            llr_in (np.array): Input LLR of all n bits, including punctured
+            ones, zero for bits not received
+
+        Returns:
+            np.array: Output LLR, length n (transmitted)
+        """
+        vec_in = ct.c_double * self.n
+        vec_out = ct.c_double * self.nct
+        in_arr = vec_in(*llr_in)
+        out_arr = vec_out()
+
+        self.lib.argtypes = (vec_in, vec_out)
+        self.lib.restype = ct.c_int
+        iter_req = self.lib.resume(ct.byref(in_arr), ct.byref(out_arr))
+
+        return np.array(out_arr[0:self.nct]), iter_req
+
+
     def simulate(self, **args):
         """Start the simulation in threaded mode.
 
         Args (optional):
             earlyTerm (bool): Terminate decoding if codeword valid
             iterations (int): Number of decoding iterations
-            decoding (str): "BP", "BP_MS"
+            decoding (str): "BP", "BP_MS", "BP_OMS", "BP_WMS", "BF", "LUT" or a cascade, e.g. "BF,BP_OMS,BP"
+            blockIterations (int): Local iterations per cache-sized layer, 0 for flooding
+            crcPoly (int): CRC polynomial for early termination, 0 to disable
+            weightFile (str): CN weight file for weighted min-sum
+            tableFile (str): Table file for lookup-table decoding
+            warmStart (bool): Cascaded decoding resumes from the previous stage
+            msOffset (float): Offset for offset min-sum
             seed (int): RNG Seed
             snr (list): [MIN, MAX, STEP]
             channel (str): "AWGN", "BSC", "BEC"
             threads (int): Number of parallel threads
             maxFrames (int): Maximum number of frames per SNR value
             fec (int): Number of error frames per SNR value
+            transmissions (int): IR-HARQ transmissions per frame, the punctured
+            bits are sent in equal parts
         """
         snr = ct.c_double * 3
         self.sim_params = {**self.sim_params, **args}
         snr = snr(*self.sim_params["snr"])
-        dec_param = decoder_param(self.sim_params["earlyTerm"], self.sim_params["iterations"], self.sim_params["decoding"].encode("utf-8"))
+        dec_param = decoder_param(self.sim_params["earlyTerm"], self.sim_params["iterations"], self.sim_params["decoding"].encode("utf-8"), self.sim_params["blockIterations"], self.sim_params["crcPoly"], self.sim_params["weightFile"].encode("utf-8"), self.sim_params["tableFile"].encode("utf-8"), self.sim_params["warmStart"], self.sim_params["msOffset"])
         ch_param = channel_param(self.sim_params["seed"], snr, self.sim_params["channel"].encode("utf-8"))
-        sim_param = simulation_param(self.sim_params["threads"], self.sim_params["maxFrames"], self.sim_params["fec"], "".encode("utf-8"))
+        sim_param = simulation_param(self.sim_params["threads"], self.sim_params["maxFrames"], self.sim_params["fec"], "".encode("utf-8"), self.sim_params["transmissions"])
 
         def sim_thread():
             self.sim_stop_flag.value = False
@@ -191,6 +257,33 @@ class LDPC:
         else:
             return self.results
 
+    def threshold(self, channel="AWGN", method="GA", decoding="BP", iters=1000, bins=512, max_llr=30.0, target_error=1e-6, tolerance=0.01):
+        """Decoding threshold of the degree distribution of the code by
+        density evolution.
+
+        Args:
+            channel (str, optional): "AWGN", "BSC" or "BEC". Defaults to "AWGN".
+            method (str, optional): "GA" (Gaussian approximation) or "DDE"
+            (discretized). Defaults to "GA".
+            decoding (str, optional): "BP" or "BP_MS", min-sum needs "DDE".
+            Defaults to "BP".
+            iters (int, optional): Most iterations. Defaults to 1000.
+            bins (int, optional): DDE quantization bins per LLR sign. Defaults to 512.
+            max_llr (float, optional): DDE LLR saturation. Defaults to 30.0.
+            target_error (float, optional): Error probability taken as
+            converged. Defaults to 1e-6.
+            tolerance (float, optional): Precision of the threshold. Defaults to 0.01.
+
+        Returns:
+            float: SNR in dB (as in simulate), or crossover or erasure
+            probability; nan if none
+        """
+        params = de_param(method.encode("utf-8"), decoding.encode("utf-8"), channel.encode("utf-8"), iters, bins, max_llr, target_error, tolerance)
+
+        self.lib.threshold.argtypes = (de_param,)
+        self.lib.threshold.restype = ct.c_double
+        return self.lib.threshold(params)
+
     def rank(self):
         """Calculate the rank of the parity-check matrix over GF(2).
 
@@ -0,0 +1,138 @@
+#include "core/ldpc.h"
+#include "core/cycles.h"
+#include "core/distance.h"
+#include "core/trapping_sets.h"
+#include "core/density_evolution.h"
+#include "../include/argparse/argparse.hpp"
+
+#include <omp.h>
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("ldpcanalyze");
+    parser.add_argument("codefile").help("LDPC codefile containing all non-zero entries, compressed sparse row (CSR) format.");
+
+    parser.add_argument("-t", "--num-threads").help("Number of threads. (Default: 1)").default_value(unsigned(1)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("-l", "--max-length").help("Longest cycle length counted. (Default: 8)").default_value(int(8)).action([](const std::string &s) { return std::stoi(s); });
+    parser.add_argument("-d", "--distance").help("Random information sets searched for low-weight codewords, 0 to skip. (Default: 0)").default_value(unsigned(0)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("-s", "--seed").help("RNG seed of the distance search. (Default: 0)").default_value(ldpc::u64(0)).action([](const std::string &s) { return std::stoull(s); });
+    parser.add_argument("--codeword-file").help("Writes the support of each minimum weight codeword found, one per line.").default_value(std::string(""));
+    parser.add_argument("--trapping-file").help("Enumerates elementary trapping sets grown from the short cycles and writes them, one \"a b v_1 ... v_a\" per line.").default_value(std::string(""));
+    parser.add_argument("--max-a").help("Most variable nodes of a trapping set. (Default: 10)").default_value(unsigned(10)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("--max-b").help("Most unsatisfied checks of a trapping set. (Default: 3)").default_value(unsigned(3)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("--threshold").help("Computes the density evolution threshold of the degree distribution on this channel, AWGN, BSC or BEC.").default_value(std::string(""));
+    parser.add_argument("--de-method").help("Density evolution: GA (Gaussian approximation) or DDE (discretized). (Default: GA)").default_value(std::string("GA"));
+    parser.add_argument("--de-decoding").help("Density evolution: BP or BP_MS, min-sum needs DDE. (Default: BP)").default_value(std::string("BP"));
+    parser.add_argument("--de-iterations").help("Most density evolution iterations. (Default: 1000)").default_value(unsigned(1000)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("--local-girth-file").help("Writes the local girth of each variable node.").default_value(std::string(""));
+
+    try
+    {
+        parser.parse_args(argc, argv);
+
+        ldpc::ldpc_code code(parser.get<std::string>("codefile"));
+        omp_set_num_threads(parser.get<ldpc::u32>("--num-threads"));
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto spectrum = ldpc::analyze_cycles(code.H(), parser.get<int>("--max-length"));
+        auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+        auto girthFile = parser.get<std::string>("--local-girth-file");
+        if (!girthFile.empty())
+        {
+            std::ofstream out(girthFile);
+            for (auto g : spectrum.varGirth)
+                out << g << "\n";
+        }
+
+        std::cout << "N : " << code.nc() << "\n";
+        std::cout << "M : " << code.mc() << "\n";
+        std::cout << spectrum;
+        std::cout << "Time : " << time << "ms" << std::endl;
+
+        if (parser.get<unsigned>("--distance") > 0)
+        {
+            ldpc::distance_param param;
+            param.seed = parser.get<ldpc::u64>("--seed");
+            param.iterations = parser.get<unsigned>("--distance");
+            param.p = 2;
+
+            start = std::chrono::high_resolution_clock::now();
+            auto dist = ldpc::estimate_min_distance(code.H(), param);
+            time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+            auto codewordFile = parser.get<std::string>("--codeword-file");
+            if (!codewordFile.empty())
+            {
+                std::ofstream out(codewordFile);
+                for (const auto &c : dist.codewords)
+                {
+                    for (auto i : c)
+                        out << i << " ";
+                    out << "\n";
+                }
+            }
+
+            std::cout << "Minimum distance (upper bound) : " << dist.dmin << "\n";
+            std::cout << "Multiplicity (found) : " << dist.multiplicity << "\n";
+            std::cout << "Time : " << time << "ms" << std::endl;
+        }
+
+        auto trappingFile = parser.get<std::string>("--trapping-file");
+        if (!trappingFile.empty())
+        {
+            ldpc::trapping_param param;
+            param.maxA = parser.get<unsigned>("--max-a");
+            param.maxB = parser.get<unsigned>("--max-b");
+            param.cycleLength = parser.get<int>("--max-length");
+            param.slack = 2;
+
+            start = std::chrono::high_resolution_clock::now();
+            auto sets = ldpc::enumerate_trapping_sets(code, param);
+            time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+            ldpc::write_trapping_sets(trappingFile, sets);
+
+            std::cout << "Trapping sets : " << sets.size() << "\n";
+            std::cout << "Time : " << time << "ms" << std::endl;
+        }
+
+        auto channel = parser.get<std::string>("--threshold");
+        if (!channel.empty())
+        {
+            auto method = parser.get<std::string>("--de-method");
+            auto decoding = parser.get<std::string>("--de-decoding");
+
+            ldpc::de_param param;
+            param.method = method.c_str();
+            param.decoding = decoding.c_str();
+            param.channel = channel.c_str();
+            param.iterations = parser.get<unsigned>("--de-iterations");
+            param.bins = 512;
+            param.maxLlr = 30;
+            param.targetError = 1e-6;
+            param.tolerance = 0.01;
+
+            start = std::chrono::high_resolution_clock::now();
+            auto threshold = ldpc::de_threshold(ldpc::degree_distribution_of(code), param);
+            time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+            std::cout << "Threshold (" << method << ", " << decoding << ", " << channel << ") : ";
+            if (std::isnan(threshold))
+                std::cout << "none";
+            else if (channel == "AWGN")
+                std::cout << threshold << "dB (sigma = " << std::pow(10, -threshold / 20) << ")";
+            else
+                std::cout << threshold;
+            std::cout << "\n";
+            std::cout << "Time : " << time << "ms" << std::endl;
+        }
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << parser;
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
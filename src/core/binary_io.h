@@ -0,0 +1,232 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ldpc
+{
+    // fixed-size scalars of the library, as stored in the binary files
+    using u64 = unsigned long;
+    using u32 = unsigned int;
+    using u8 = unsigned char;
+
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     */
+    class mapped_file
+    {
+    public:
+        mapped_file() = default;
+
+        /**
+         * @brief Map a file into memory.
+         *
+         * @throw runtime_error if the file can not be opened
+         * @param filename File name
+         */
+        explicit mapped_file(const std::string &filename)
+        {
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("can not open file for reading");
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("can not open file for reading");
+            }
+
+            mSize = st.st_size;
+            if (mSize > 0)
+            {
+                void *p = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("can not map file");
+                }
+                mData = static_cast<const char *>(p);
+            }
+            ::close(fd);
+        }
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        ~mapped_file()
+        {
+            if (mData)
+                ::munmap(const_cast<char *>(mData), mSize);
+        }
+
+        const char *data() const { return mData; }
+        std::size_t size() const { return mSize; }
+
+    private:
+        const char *mData = nullptr;
+        std::size_t mSize = 0;
+    };
+
+    /**
+     * @brief 64-bit FNV-1a hash of a byte range.
+     *
+     * @param data First byte
+     * @param size Number of bytes
+     * @param seed Hash to continue from
+     * @return u64 Hash value
+     */
+    inline u64 content_hash(const char *data, const std::size_t size, u64 seed = 0xcbf29ce484222325UL)
+    {
+        u64 h = seed;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 0x100000001b3UL;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Appends plain values and arrays to a byte buffer. Nested
+     * arrays are stored flat with their row offsets.
+     */
+    class binary_writer
+    {
+    public:
+        template <typename T>
+        void put(const T &v)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary_writer: type must be trivially copyable");
+            mBuffer.append(reinterpret_cast<const char *>(&v), sizeof(T));
+        }
+
+        template <typename T>
+        void put(const std::vector<T> &v)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary_writer: type must be trivially copyable");
+            put<u64>(v.size());
+            mBuffer.append(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(T));
+        }
+
+        template <typename T>
+        void put(const std::vector<std::vector<T>> &v)
+        {
+            std::vector<u64> offsets(1, 0);
+            for (const auto &row : v)
+                offsets.push_back(offsets.back() + row.size());
+
+            put(offsets);
+            for (const auto &row : v)
+                mBuffer.append(reinterpret_cast<const char *>(row.data()), row.size() * sizeof(T));
+        }
+
+        /**
+         * @brief Write the buffer to a temporary file that replaces the
+         * target, so concurrent readers never see a partial file.
+         *
+         * @return bool True on success
+         */
+        bool write_to_file(const std::string &filename) const
+        {
+            auto tmp = filename + ".tmp" + std::to_string(::getpid());
+            {
+                std::ofstream out(tmp, std::ios::binary);
+                if (!out.good())
+                    return false;
+                out.write(mBuffer.data(), mBuffer.size());
+                if (!out.good())
+                {
+                    std::remove(tmp.c_str());
+                    return false;
+                }
+            }
+            return std::rename(tmp.c_str(), filename.c_str()) == 0;
+        }
+
+    private:
+        std::string mBuffer;
+    };
+
+    /**
+     * @brief Reads the values of a binary_writer from memory.
+     */
+    class binary_reader
+    {
+    public:
+        binary_reader(const char *data, const std::size_t size)
+            : mData(data), mEnd(data + size) {}
+
+        template <typename T>
+        void get(T &v)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary_reader: type must be trivially copyable");
+            std::memcpy(&v, take(sizeof(T)), sizeof(T));
+        }
+
+        template <typename T>
+        void get(std::vector<T> &v)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary_reader: type must be trivially copyable");
+            u64 n;
+            get(n);
+            auto p = take_n(n, sizeof(T));
+            v.resize(n);
+            if (n > 0)
+                std::memcpy(static_cast<void *>(v.data()), p, n * sizeof(T));
+        }
+
+        template <typename T>
+        void get(std::vector<std::vector<T>> &v)
+        {
+            std::vector<u64> offsets;
+            get(offsets);
+            if (offsets.empty())
+                throw std::runtime_error("binary_reader: corrupt file");
+
+            v.resize(offsets.size() - 1);
+            for (std::size_t i = 0; i < v.size(); ++i)
+            {
+                if (offsets[i + 1] < offsets[i])
+                    throw std::runtime_error("binary_reader: corrupt file");
+
+                const auto n = offsets[i + 1] - offsets[i];
+                auto p = take_n(n, sizeof(T));
+                v[i].resize(n);
+                if (n > 0)
+                    std::memcpy(static_cast<void *>(v[i].data()), p, n * sizeof(T));
+            }
+        }
+
+    private:
+        // n elements of the given size, checked before anything is allocated
+        const char *take_n(const std::size_t n, const std::size_t size)
+        {
+            if (n > static_cast<std::size_t>(mEnd - mData) / size)
+                throw std::runtime_error("binary_reader: unexpected end of file");
+            return take(n * size);
+        }
+
+        const char *take(const std::size_t bytes)
+        {
+            if (static_cast<std::size_t>(mEnd - mData) < bytes)
+                throw std::runtime_error("binary_reader: unexpected end of file");
+            auto p = mData;
+            mData += bytes;
+            return p;
+        }
+
+        const char *mData;
+        const char *mEnd;
+    };
+} // namespace ldpc
@@ -0,0 +1,421 @@
+#include "bit_matrix.h"
+
+namespace ldpc
+{
+    bit_matrix::bit_matrix(const sparse_csr<bits_t> &A)
+        : bit_matrix(A.num_rows(), A.num_cols())
+    {
+        for (const auto &e : A.nz_entry())
+        {
+            if (e.value.value)
+                set(e.rowIndex, e.colIndex);
+        }
+    }
+
+    void bit_matrix::swap_rows(const int i, const int j)
+    {
+        std::swap_ranges(row(i), row(i) + mWords, row(j));
+    }
+
+    void bit_matrix::add_row(const int dest, const int src, const int w)
+    {
+        auto d = row(dest);
+        auto s = row(src);
+        for (int k = w; k < mWords; ++k)
+        {
+            d[k] ^= s[k];
+        }
+    }
+
+    vec_int bit_matrix::echelonize()
+    {
+        // a block is one word of columns, with a table per 8 columns
+        constexpr int K = 8;
+        constexpr int TABLES = 64 / K;
+
+        vec_int pivots;
+        vec_u64 table;
+
+        int r = 0;
+        for (int w0 = 0; w0 < mWords && r < mRows; ++w0)
+        {
+            const int c0 = w0 * 64;
+            const int c1 = std::min(c0 + 64, mCols);
+
+            // find the pivots of the block among the remaining rows, the pivots
+            // are kept reduced against each other so the bit of a candidate row
+            // after reduction follows from its bits at the earlier pivot columns
+            vec_int blockCols;
+            for (int c = c0; c < c1 && r + static_cast<int>(blockCols.size()) < mRows; ++c)
+            {
+                const int found = blockCols.size();
+                int p = r + found;
+                for (; p < mRows; ++p)
+                {
+                    bool b = get(p, c);
+                    for (int q = 0; q < found; ++q)
+                    {
+                        if (get(p, blockCols[q]))
+                            b ^= get(r + q, c);
+                    }
+                    if (b)
+                        break;
+                }
+                if (p == mRows)
+                    continue;
+
+                for (int q = 0; q < found; ++q)
+                {
+                    if (get(p, blockCols[q]))
+                        add_row(p, r + q, w0);
+                }
+                swap_rows(p, r + found);
+
+                for (int q = 0; q < found; ++q)
+                {
+                    if (get(r + q, c))
+                        add_row(r + q, r + found, w0);
+                }
+                blockCols.push_back(c);
+            }
+
+            const int found = blockCols.size();
+            if (found == 0)
+                continue;
+
+            // sums of the pivot rows of each group of K columns, indexed by their
+            // bits in the group; each entry adds one pivot row to an entry with
+            // one bit less
+            const int width = mWords - w0;
+            std::array<u64, TABLES> mask{};
+            vec_int pivotRow(64, -1);
+            for (int q = 0; q < found; ++q)
+            {
+                const int b = blockCols[q] - c0;
+                mask[b / K] |= u64(1) << (b % K);
+                pivotRow[b] = r + q;
+            }
+
+            table.resize(static_cast<u64>(TABLES << K) * mWords);
+            auto entry = [&](const int g, const u64 idx) { return table.data() + ((static_cast<u64>(g) << K) + idx) * width; };
+            for (int g = 0; g < TABLES; ++g)
+            {
+                std::fill(entry(g, 0), entry(g, 0) + width, 0);
+                for (u64 idx = 1; idx <= mask[g]; ++idx)
+                {
+                    if (idx & ~mask[g])
+                        continue;
+
+                    auto t = entry(g, idx);
+                    auto prev = entry(g, idx & (idx - 1));
+                    auto pivot = row(pivotRow[g * K + __builtin_ctzl(idx)]) + w0;
+                    for (int w = 0; w < width; ++w)
+                    {
+                        t[w] = prev[w] ^ pivot[w];
+                    }
+                }
+            }
+
+            // clear the pivot columns of all other rows in one pass per row
+            const int rEnd = r + found;
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < mRows; ++i)
+            {
+                if (i >= r && i < rEnd)
+                    continue;
+
+                auto d = row(i) + w0;
+                if (d[0] == 0)
+                    continue;
+
+                std::array<const u64 *, TABLES> t;
+                int num = 0;
+                for (int g = 0; g < TABLES; ++g)
+                {
+                    const u64 idx = (d[0] >> (g * K)) & mask[g];
+                    if (idx != 0)
+                        t[num++] = entry(g, idx);
+                }
+
+                for (int w = 0; w < width; ++w)
+                {
+                    u64 x = 0;
+                    for (int j = 0; j < num; ++j)
+                        x ^= t[j][w];
+                    d[w] ^= x;
+                }
+            }
+
+            pivots.insert(pivots.end(), blockCols.begin(), blockCols.end());
+            r += found;
+        }
+
+        return pivots;
+    }
+
+    sparse_csr<bits_t> bit_matrix::to_sparse() const
+    {
+        std::vector<edge<bits_t>> edges;
+        for (int i = 0; i < mRows; ++i)
+        {
+            const auto a = row(i);
+            for (int w = 0; w < mWords; ++w)
+            {
+                for (u64 bits = a[w]; bits != 0; bits &= bits - 1)
+                    edges.push_back(edge<bits_t>({i, w * 64 + __builtin_ctzl(bits), 1}));
+            }
+        }
+        return sparse_csr<bits_t>(mRows, mCols, edges);
+    }
+
+    void bit_matrix::write_to_file(const std::string &filename) const
+    {
+        std::ofstream outfile(filename, std::ios::binary);
+
+        if (!outfile.good())
+            throw std::runtime_error("can not open file for writing");
+
+        // "row col" per non-zero entry, formatted into a buffer per row
+        std::string line;
+        char buf[32];
+        for (int i = 0; i < mRows; ++i)
+        {
+            line.clear();
+            const auto rowEnd = std::to_chars(buf, buf + sizeof(buf), i).ptr;
+            *rowEnd = ' ';
+
+            const auto a = row(i);
+            for (int w = 0; w < mWords; ++w)
+            {
+                for (u64 bits = a[w]; bits != 0; bits &= bits - 1)
+                {
+                    auto end = std::to_chars(rowEnd + 1, buf + sizeof(buf), w * 64 + __builtin_ctzl(bits)).ptr;
+                    *end++ = '\n';
+                    line.append(buf, end);
+                }
+            }
+            outfile.write(line.data(), line.size());
+        }
+    }
+
+    bit_matrix generator_matrix(const sparse_csr<bits_t> &H, vec_int &perm, int k)
+    {
+        const int n = H.num_cols();
+
+        bit_matrix A(H);
+        const auto pivots = A.echelonize();
+        const int rank = pivots.size();
+        const int dim = n - rank;
+
+        if (dim == 0)
+            throw std::runtime_error("generator_matrix(): H has full column rank");
+        if (k < 0)
+            k = dim;
+        if (k > dim)
+            throw std::runtime_error("generator_matrix(): more rows than the dimension of the code");
+
+        std::vector<bool> isPivot(n, false);
+        for (auto c : pivots)
+            isPivot[c] = true;
+
+        // information index of each free column
+        vec_int info(n, -1);
+        perm.clear();
+        for (int j = 0; j < n; ++j)
+        {
+            if (!isPivot[j])
+            {
+                info[j] = perm.size();
+                perm.push_back(j);
+            }
+        }
+        perm.insert(perm.end(), pivots.begin(), pivots.end());
+
+        // row i of G is the unit vector at the i-th free column plus every pivot
+        // column whose row of the echelon form holds that free column
+        bit_matrix G(dim, n);
+        for (int i = 0; i < dim; ++i)
+            G.set(i, perm[i]);
+
+        for (int j = 0; j < rank; ++j)
+        {
+            const auto a = A.row(j);
+            for (int w = 0; w < A.num_words(); ++w)
+            {
+                for (u64 bits = a[w]; bits != 0; bits &= bits - 1)
+                {
+                    const int c = w * 64 + __builtin_ctzl(bits);
+                    if (info[c] >= 0)
+                        G.set(info[c], pivots[j]);
+                }
+            }
+        }
+
+        // rows beyond k are added to the first rows, which keeps the
+        // information columns of weight one but no column all-zero,
+        // without rows there is nothing to add them to
+        for (int i = k; i < dim && k > 0; ++i)
+            G.add_row((i - k) % k, i);
+
+        G.resize_rows(k);
+        return G;
+    }
+
+    int gf2_rank(const std::vector<std::vector<node>> &rowN, const int numCols)
+    {
+        const int m = rowN.size();
+
+        // sorted column indices of each row, a pair of equal entries cancels
+        std::vector<vec_int> rows(m);
+        vec_int colCount(numCols, 0);
+        mat_int colRows(numCols);
+        u64 nnz = 0;
+        for (int i = 0; i < m; ++i)
+        {
+            vec_int cols;
+            for (const auto &n : rowN[i])
+                cols.push_back(n.nodeIndex);
+            std::sort(cols.begin(), cols.end());
+            for (u64 k = 0; k < cols.size(); ++k)
+            {
+                if (k + 1 < cols.size() && cols[k] == cols[k + 1])
+                    ++k;
+                else
+                    rows[i].push_back(cols[k]);
+            }
+
+            for (auto c : rows[i])
+            {
+                ++colCount[c];
+                colRows[c].push_back(i);
+            }
+            nnz += rows[i].size();
+        }
+
+        // Markowitz-style sparse elimination: the column of fewest entries is
+        // eliminated with its shortest row, which keeps the fill-in low; stale
+        // queue entries are skipped
+        using entry = std::pair<int, int>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+        for (int c = 0; c < numCols; ++c)
+            queue.push(entry(colCount[c], c));
+
+        std::vector<bool> rowActive(m, true);
+        std::vector<bool> colActive(numCols, true);
+        u64 activeRows = m;
+        u64 activeCols = numCols;
+
+        int rank = 0;
+        vec_int seen(m, -1);
+        vec_int targets;
+        while (!queue.empty() && activeRows > 0)
+        {
+            // continue dense once the remaining part is no longer sparse
+            if (nnz * 32 > activeRows * activeCols)
+                break;
+
+            const auto [count, j] = queue.top();
+            queue.pop();
+            if (!colActive[j] || count != colCount[j])
+                continue;
+
+            colActive[j] = false;
+            --activeCols;
+            if (count == 0)
+                continue;
+
+            // rows holding column j, a row is listed twice if it lost and regained j
+            targets.clear();
+            for (auto i : colRows[j])
+            {
+                if (rowActive[i] && seen[i] != j && std::binary_search(rows[i].begin(), rows[i].end(), j))
+                {
+                    seen[i] = j;
+                    targets.push_back(i);
+                }
+            }
+            colRows[j].clear();
+
+            auto shortest = std::min_element(targets.begin(), targets.end(), [&rows](const int a, const int b) { return rows[a].size() < rows[b].size(); });
+            const int pivot = *shortest;
+            std::swap(*shortest, targets.back());
+            targets.pop_back();
+
+            rowActive[pivot] = false;
+            --activeRows;
+            ++rank;
+
+            const auto &p = rows[pivot];
+            for (auto c : p)
+                --colCount[c];
+            nnz -= p.size();
+
+            for (auto i : targets)
+                nnz -= rows[i].size();
+
+            // each row adds the pivot row, independent of the others
+            #pragma omp parallel for schedule(dynamic, 16) if (targets.size() > 256)
+            for (u64 t = 0; t < targets.size(); ++t)
+            {
+                auto &r = rows[targets[t]];
+                vec_int sum;
+                sum.reserve(r.size() + p.size());
+                std::set_symmetric_difference(r.begin(), r.end(), p.begin(), p.end(), std::back_inserter(sum));
+                r.swap(sum);
+            }
+
+            // the pivot row toggles its columns in each row
+            for (auto i : targets)
+            {
+                nnz += rows[i].size();
+                for (auto c : p)
+                {
+                    if (std::binary_search(rows[i].begin(), rows[i].end(), c))
+                    {
+                        ++colCount[c];
+                        colRows[c].push_back(i);
+                    }
+                    else
+                    {
+                        --colCount[c];
+                    }
+                }
+            }
+
+            for (auto c : p)
+            {
+                if (colActive[c])
+                    queue.push(entry(colCount[c], c));
+            }
+            vec_int().swap(rows[pivot]);
+        }
+
+        if (activeRows == 0 || nnz == 0)
+            return rank;
+
+        // dense elimination of the remaining rows and columns
+        vec_int colIndex(numCols, -1);
+        int n = 0;
+        for (int c = 0; c < numCols; ++c)
+        {
+            if (colActive[c] && colCount[c] > 0)
+                colIndex[c] = n++;
+        }
+
+        vec_int rowIndex;
+        for (int i = 0; i < m; ++i)
+        {
+            if (rowActive[i] && !rows[i].empty())
+                rowIndex.push_back(i);
+        }
+
+        bit_matrix D(rowIndex.size(), n);
+        for (u64 r = 0; r < rowIndex.size(); ++r)
+        {
+            for (auto c : rows[rowIndex[r]])
+                D.set(r, colIndex[c]);
+        }
+
+        return rank + D.echelonize().size();
+    }
+} // namespace ldpc
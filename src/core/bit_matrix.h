@@ -0,0 +1,101 @@
+#pragma once
+
+#include "functions.h"
+
+#include <array>
+#include <charconv>
+#include <queue>
+
+namespace ldpc
+{
+    /**
+     * @brief Dense matrix over GF(2) with rows packed into 64-bit words.
+     *
+     * Rows are padded to whole words, so row operations are word-wise
+     * XORs. Intended for eliminations that fill in quickly, e.g. deriving
+     * G from H.
+     */
+    class bit_matrix
+    {
+    public:
+        bit_matrix() = default;
+        bit_matrix(const int m, const int n)
+            : mRows(m),
+              mCols(n),
+              mWords((n + 63) / 64),
+              mData(static_cast<u64>(m) * mWords, 0)
+        {
+        }
+
+        // Copy of a sparse matrix
+        bit_matrix(const sparse_csr<bits_t> &A);
+
+        bool get(const int i, const int j) const { return (mData[i * mWords + j / 64] >> (j % 64)) & 1; }
+        void set(const int i, const int j) { mData[i * mWords + j / 64] |= u64(1) << (j % 64); }
+        void flip(const int i, const int j) { mData[i * mWords + j / 64] ^= u64(1) << (j % 64); }
+
+        // First word of row i
+        u64 *row(const int i) { return mData.data() + static_cast<u64>(i) * mWords; }
+        const u64 *row(const int i) const { return mData.data() + static_cast<u64>(i) * mWords; }
+
+        void swap_rows(const int i, const int j);
+
+        // Keep the first m rows
+        void resize_rows(const int m)
+        {
+            mRows = m;
+            mData.resize(static_cast<u64>(m) * mWords);
+        }
+
+        // Add row src to row dest, starting at word w
+        void add_row(const int dest, const int src, const int w = 0);
+
+        /**
+         * @brief Transform to reduced row echelon form with the Method of
+         * Four Russians, the row reduction of each column block is run in
+         * parallel.
+         *
+         * The pivots of a word of columns are found first. For each 8 of
+         * its columns, all sums of the pivot rows are tabulated, and each
+         * other row then clears the word with one lookup per table in a
+         * single pass.
+         *
+         * @return vec_int Pivot column of each of the first rank() rows
+         */
+        vec_int echelonize();
+
+        // Sparse copy of the non-zero entries
+        sparse_csr<bits_t> to_sparse() const;
+
+        // Write the non-zero entries in sparse CSR format, one "row col" line per entry
+        void write_to_file(const std::string &filename) const;
+
+        int num_rows() const { return mRows; }
+        int num_cols() const { return mCols; }
+        int num_words() const { return mWords; }
+
+    private:
+        int mRows = 0;
+        int mCols = 0;
+        int mWords = 0;
+        vec_u64 mData;
+    };
+
+    /**
+     * @brief Derive a systematic generator matrix from H.
+     *
+     * H is brought into reduced row echelon form, its pivot columns
+     * become the parity bits and the free columns the information bits,
+     * i.e. G is the identity on the information columns. Columns keep
+     * their order in H.
+     *
+     * @throw runtime_error if H has full column rank
+     * @param H Parity-check matrix
+     * @param perm Column permutation, the information columns followed by the parity columns
+     * @param k Number of rows of G, -1 for the dimension n - rank(H). With fewer
+     *          rows, the rows of the remaining free columns are added to the
+     *          first rows, i.e. G spans a subcode.
+     * @return bit_matrix Generator matrix
+     */
+    bit_matrix generator_matrix(const sparse_csr<bits_t> &H, vec_int &perm, int k = -1);
+} // namespace ldpc
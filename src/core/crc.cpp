@@ -0,0 +1,105 @@
+#include "crc.h"
+
+namespace ldpc
+{
+    crc::crc(const u64 polynomial)
+        : mWidth(0),
+          mPoly(0),
+          mMask(0),
+          mTable(256)
+    {
+        if (polynomial < 2)
+            throw std::runtime_error("crc(): invalid polynomial");
+
+        // degree of the polynomial
+        while ((polynomial >> (mWidth + 1)) != 0)
+            ++mWidth;
+
+        if (mWidth > 63)
+            throw std::runtime_error("crc(): polynomial degree exceeds 63");
+
+        mMask = (u64(1) << mWidth) - 1;
+        mPoly = polynomial & mMask;
+
+        // remainder of each byte for byte-wise processing
+        if (mWidth >= 8)
+        {
+            for (u64 b = 0; b < 256; ++b)
+            {
+                u64 r = b << (mWidth - 8);
+                for (int i = 0; i < 8; ++i)
+                {
+                    r = (r >> (mWidth - 1)) & 1 ? (r << 1) ^ mPoly : (r << 1);
+                }
+                mTable[b] = r & mMask;
+            }
+        }
+    }
+
+    template <typename F>
+    u64 crc::remainder(F bit, const int len) const
+    {
+        u64 r = 0;
+        int i = 0;
+
+        if (mWidth >= 8)
+        {
+            for (; i + 8 <= len; i += 8)
+            {
+                u64 byte = 0;
+                for (int j = 0; j < 8; ++j)
+                {
+                    byte = (byte << 1) | bit(i + j);
+                }
+                r = ((r << 8) & mMask) ^ mTable[((r >> (mWidth - 8)) ^ byte) & 0xff];
+            }
+        }
+
+        // remaining bits
+        for (; i < len; ++i)
+        {
+            u64 top = ((r >> (mWidth - 1)) & 1) ^ bit(i);
+            r = (r << 1) & mMask;
+            if (top)
+                r ^= mPoly;
+        }
+
+        return r;
+    }
+
+    u64 crc::checksum(const vec_bits_t &bits, const int len) const
+    {
+        return remainder([&bits](const int i) { return bits[i].value; }, len);
+    }
+
+    u64 crc::checksum(const vec_bits_t &bits, const vec_int &pos, const int len) const
+    {
+        return remainder([&bits, &pos](const int i) { return bits[pos[i]].value; }, len);
+    }
+
+    void crc::append(vec_bits_t &bits) const
+    {
+        const int len = bits.size() - mWidth;
+        if (len < 0)
+            throw std::runtime_error("crc::append(): word shorter than checksum");
+
+        auto r = checksum(bits, len);
+        for (int j = 0; j < mWidth; ++j)
+        {
+            bits[len + j] = (r >> (mWidth - 1 - j)) & 1;
+        }
+    }
+
+    void crc::append(vec_bits_t &bits, const vec_int &pos) const
+    {
+        const int len = pos.size() - mWidth;
+        if (len < 0)
+            throw std::runtime_error("crc::append(): word shorter than checksum");
+
+        auto r = checksum(bits, pos, len);
+        for (int j = 0; j < mWidth; ++j)
+        {
+            bits[pos[len + j]] = (r >> (mWidth - 1 - j)) & 1;
+        }
+    }
+} // namespace ldpc
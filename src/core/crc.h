@@ -0,0 +1,80 @@
+#pragma once
+
+#include "functions.h"
+
+namespace ldpc
+{
+    /**
+     * @brief Table-driven cyclic redundancy check over bit vectors.
+     * 
+     * The register is initialized to zero and processed MSB first, so a word
+     * with its checksum appended has a zero remainder.
+     */
+    class crc
+    {
+    public:
+        crc() = default;
+
+        /**
+         * @brief Construct a new crc object.
+         * 
+         * @param polynomial Generator polynomial including the leading term,
+         * e.g. 0x1864CFB for CRC24A (x^24 + x^23 + ... + 1).
+         */
+        crc(const u64 polynomial);
+
+        /**
+         * @brief Compute the remainder of the first len bits.
+         * 
+         * @param bits Input bits
+         * @param len Number of bits
+         * @return u64 Remainder
+         */
+        u64 checksum(const vec_bits_t &bits, const int len) const;
+
+        /**
+         * @brief Compute the remainder of the bits at the first len positions.
+         * 
+         * @param bits Input bits
+         * @param pos Positions of the checked bits in bits
+         * @param len Number of bits
+         * @return u64 Remainder
+         */
+        u64 checksum(const vec_bits_t &bits, const vec_int &pos, const int len) const;
+
+        /**
+         * @brief Write the checksum of the leading bits into the last width() bits.
+         * 
+         * @param bits Information word
+         */
+        void append(vec_bits_t &bits) const;
+
+        /**
+         * @brief Write the checksum of the bits at the leading positions into
+         * the bits at the last width() positions, e.g. skipping shortened bits.
+         * 
+         * @param bits Information word
+         * @param pos Positions of the checked bits in bits
+         */
+        void append(vec_bits_t &bits, const vec_int &pos) const;
+
+        // Returns true if the word including its appended checksum is valid.
+        bool check(const vec_bits_t &bits) const { return checksum(bits, bits.size()) == 0; }
+
+        // Returns true if the bits at pos including their appended checksum are valid.
+        bool check(const vec_bits_t &bits, const vec_int &pos) const { return checksum(bits, pos, pos.size()) == 0; }
+
+        // Number of checksum bits
+        int width() const { return mWidth; }
+
+    private:
+        // remainder of bit(0), ..., bit(len - 1)
+        template <typename F>
+        u64 remainder(F bit, const int len) const;
+
+        int mWidth;
+        u64 mPoly;
+        u64 mMask;
+        std::vector<u64> mTable;
+    };
+} // namespace ldpc
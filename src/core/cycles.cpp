@@ -0,0 +1,335 @@
+#include "cycles.h"
+
+#include <map>
+
+namespace ldpc
+{
+    namespace
+    {
+        /**
+         * @brief Tanner graph in flat adjacency arrays, variable nodes
+         * 0..n-1 followed by check nodes n..n+m-1.
+         */
+        struct tanner_graph
+        {
+            tanner_graph(const std::vector<std::vector<node>> &varN, const std::vector<std::vector<node>> &checkN)
+                : n(varN.size()),
+                  offset(1, 0)
+            {
+                for (const auto &col : varN)
+                {
+                    for (const auto &c : col)
+                        adj.push_back(n + c.nodeIndex);
+                    offset.push_back(adj.size());
+                }
+                for (const auto &row : checkN)
+                {
+                    for (const auto &v : row)
+                        adj.push_back(v.nodeIndex);
+                    offset.push_back(adj.size());
+                }
+            }
+
+            const int *begin(const int x) const { return adj.data() + offset[x]; }
+            const int *end(const int x) const { return adj.data() + offset[x + 1]; }
+            int size() const { return offset.size() - 1; }
+
+            int n;
+            vec_int offset;
+            vec_int adj;
+        };
+
+        /**
+         * @brief BFS state of one thread, stamped so it is never cleared.
+         */
+        class girth_search
+        {
+        public:
+            explicit girth_search(const int size)
+                : mState(size, {0, 0, 0}) {}
+
+            // length of the shortest cycle through s, 0 if none
+            int operator()(const tanner_graph &g, const int s)
+            {
+                ++mStamp;
+                mState[s] = {mStamp, -1, 0};
+
+                // each neighbour of s roots its own branch
+                mFrontier.clear();
+                for (auto y = g.begin(s); y != g.end(s); ++y)
+                {
+                    if (mState[*y].mark == mStamp)
+                        continue;
+                    mState[*y] = {mStamp, *y, 1};
+                    mFrontier.push_back(*y);
+                }
+
+                for (int depth = 1; !mFrontier.empty(); ++depth)
+                {
+                    int shortest = 0;
+                    mNext.clear();
+                    for (auto x : mFrontier)
+                    {
+                        const int branch = mState[x].branch;
+                        for (auto y = g.begin(x); y != g.end(x); ++y)
+                        {
+                            auto &state = mState[*y];
+                            if (state.mark != mStamp)
+                            {
+                                state = {mStamp, branch, depth + 1};
+                                mNext.push_back(*y);
+                            }
+                            else if (state.branch != branch && state.dist >= depth)
+                            {
+                                // the tree paths of both branches only meet at s
+                                const int length = depth + state.dist + 1;
+                                if (shortest == 0 || length < shortest)
+                                    shortest = length;
+                            }
+                        }
+                    }
+
+                    if (shortest > 0)
+                        return shortest;
+                    std::swap(mFrontier, mNext);
+                }
+                return 0;
+            }
+
+        private:
+            struct node_state
+            {
+                u32 mark;
+                int branch; // neighbour of the start node the node was reached through
+                int dist;
+            };
+
+            u32 mStamp = 0;
+            std::vector<node_state> mState;
+            vec_int mFrontier;
+            vec_int mNext;
+        };
+
+        /**
+         * @brief Short cycles whose least variable node is the start node,
+         * found in the middle.
+         *
+         * A cycle of length 2L splits at its start node and the node
+         * opposite into two paths of length L with disjoint interiors. All
+         * simple paths of length up to the half length are enumerated and
+         * grouped by length and end node, and each disjoint pair in a group
+         * is one cycle. This needs far fewer paths than closing the cycles.
+         */
+        class cycle_search
+        {
+        public:
+            // with cycles given, the variable nodes of each cycle are collected
+            cycle_search(const int size, const int maxHalf, std::vector<vec_int> *cycles = nullptr)
+                : mOnPath(size, false), mCount(maxHalf - 1, 0), mMaxHalf(maxHalf), mPath(maxHalf + 1), mCycles(cycles) {}
+
+            void operator()(const tanner_graph &g, const int v)
+            {
+                mStart = v;
+                mPaths.clear();
+                mPath[0] = v;
+                mOnPath[v] = true;
+                extend(g, v, 1);
+                mOnPath[v] = false;
+
+                // records are (length, end, interior nodes)
+                const int width = mMaxHalf + 1;
+                const int num = mPaths.size() / width;
+                mOrder.resize(num);
+                for (int i = 0; i < num; ++i)
+                    mOrder[i] = i * width;
+                std::sort(mOrder.begin(), mOrder.end(), [this](int a, int b) {
+                    return mPaths[a] < mPaths[b] || (mPaths[a] == mPaths[b] && mPaths[a + 1] < mPaths[b + 1]);
+                });
+
+                for (int i = 0; i < num; ++i)
+                {
+                    const int *p = &mPaths[mOrder[i]];
+                    for (int j = i + 1; j < num; ++j)
+                    {
+                        const int *q = &mPaths[mOrder[j]];
+                        if (q[0] != p[0] || q[1] != p[1])
+                            break;
+                        if (disjoint(p + 2, q + 2, p[0] - 1))
+                        {
+                            ++mCount[p[0] - 2];
+                            if (mCycles)
+                                collect(g.n, p, q);
+                        }
+                    }
+                }
+            }
+
+            u64 count(const int k) const { return mCount[k]; }
+
+        private:
+            void extend(const tanner_graph &g, const int x, const int len)
+            {
+                for (auto y = g.begin(x); y != g.end(x); ++y)
+                {
+                    // variable nodes of the cycle follow the start node
+                    if (mOnPath[*y] || (*y < g.n && *y < mStart))
+                        continue;
+
+                    if (len >= 2)
+                    {
+                        mPaths.push_back(len);
+                        mPaths.push_back(*y);
+                        mPaths.insert(mPaths.end(), mPath.begin() + 1, mPath.begin() + len);
+                        mPaths.resize(mPaths.size() + mMaxHalf - len, -1);
+                    }
+
+                    if (len < mMaxHalf)
+                    {
+                        mOnPath[*y] = true;
+                        mPath[len] = *y;
+                        extend(g, *y, len + 1);
+                        mOnPath[*y] = false;
+                    }
+                }
+            }
+
+            void collect(const int n, const int *p, const int *q)
+            {
+                vec_int vars(1, mStart);
+                if (p[1] < n)
+                    vars.push_back(p[1]);
+                for (int i = 0; i < p[0] - 1; ++i)
+                {
+                    if (p[2 + i] < n)
+                        vars.push_back(p[2 + i]);
+                    if (q[2 + i] < n)
+                        vars.push_back(q[2 + i]);
+                }
+                std::sort(vars.begin(), vars.end());
+                mCycles->push_back(vars);
+            }
+
+            static bool disjoint(const int *a, const int *b, const int n)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        if (a[i] == b[j])
+                            return false;
+                    }
+                }
+                return true;
+            }
+
+            std::vector<bool> mOnPath;
+            std::vector<u64> mCount;
+            int mMaxHalf;
+            int mStart = 0;
+            vec_int mPath;
+            vec_int mPaths;
+            vec_int mOrder;
+            std::vector<vec_int> *mCycles;
+        };
+    } // namespace
+
+    vec_int local_girth(const sparse_csr<bits_t> &H, const bool checks)
+    {
+        tanner_graph g(H.col_neighbor(), H.row_neighbor());
+        const int first = checks ? g.n : 0;
+        const int num = checks ? H.num_rows() : H.num_cols();
+
+        vec_int girth(num, 0);
+        #pragma omp parallel
+        {
+            girth_search search(g.size());
+            #pragma omp for schedule(dynamic, 64)
+            for (int i = 0; i < num; ++i)
+            {
+                girth[i] = search(g, first + i);
+            }
+        }
+        return girth;
+    }
+
+    std::vector<u64> count_cycles(const sparse_csr<bits_t> &H, const int maxLength)
+    {
+        const int maxHalf = maxLength / 2;
+        if (maxHalf < 2)
+            throw std::runtime_error("count_cycles: cycles are at least of length 4");
+
+        tanner_graph g(H.col_neighbor(), H.row_neighbor());
+        std::vector<u64> cycles(maxHalf - 1, 0);
+        #pragma omp parallel
+        {
+            cycle_search search(g.size(), maxHalf);
+            #pragma omp for schedule(dynamic, 64)
+            for (int v = 0; v < g.n; ++v)
+            {
+                search(g, v);
+            }
+
+            #pragma omp critical
+            for (int k = 0; k < maxHalf - 1; ++k)
+                cycles[k] += search.count(k);
+        }
+        return cycles;
+    }
+
+    std::vector<vec_int> find_cycles(const std::vector<std::vector<node>> &varN, const std::vector<std::vector<node>> &checkN, const int maxLength)
+    {
+        const int maxHalf = maxLength / 2;
+        if (maxHalf < 2)
+            throw std::runtime_error("find_cycles: cycles are at least of length 4");
+
+        tanner_graph g(varN, checkN);
+        std::vector<vec_int> cycles;
+        #pragma omp parallel
+        {
+            std::vector<vec_int> local;
+            cycle_search search(g.size(), maxHalf, &local);
+            #pragma omp for schedule(dynamic, 64)
+            for (int v = 0; v < g.n; ++v)
+            {
+                search(g, v);
+            }
+
+            #pragma omp critical
+            cycles.insert(cycles.end(), local.begin(), local.end());
+        }
+
+        // independent of the thread schedule
+        std::sort(cycles.begin(), cycles.end());
+        return cycles;
+    }
+
+    cycle_spectrum analyze_cycles(const sparse_csr<bits_t> &H, const int maxLength)
+    {
+        cycle_spectrum s;
+        s.varGirth = local_girth(H, false);
+        s.checkGirth = local_girth(H, true);
+        s.cycles = count_cycles(H, maxLength);
+
+        for (auto g : s.varGirth)
+        {
+            if (g > 0 && (s.girth == 0 || g < s.girth))
+                s.girth = g;
+        }
+        return s;
+    }
+
+    std::ostream &operator<<(std::ostream &os, const cycle_spectrum &s)
+    {
+        os << "Girth : " << s.girth << "\n";
+        for (u64 k = 0; k < s.cycles.size(); ++k)
+            os << "Cycles of length " << 4 + 2 * k << " : " << s.cycles[k] << "\n";
+
+        // histogram of the local girth of the variable nodes
+        std::map<int, int> hist;
+        for (auto g : s.varGirth)
+            ++hist[g];
+        for (const auto &h : hist)
+            os << "Variable nodes of local girth " << h.first << " : " << h.second << "\n";
+        return os;
+    }
+} // namespace ldpc
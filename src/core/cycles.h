@@ -0,0 +1,64 @@
+#pragma once
+
+#include "functions.h"
+
+namespace ldpc
+{
+    /**
+     * @brief Girth and short cycles of a Tanner graph.
+     */
+    struct cycle_spectrum
+    {
+        int girth = 0;          // length of the shortest cycle, 0 if acyclic
+        vec_int varGirth;       // length of the shortest cycle through each variable node, 0 if none
+        vec_int checkGirth;     // length of the shortest cycle through each check node, 0 if none
+        std::vector<u64> cycles; // number of cycles of length 4, 6, ...
+    };
+
+    /**
+     * @brief Local girth of the variable or check nodes.
+     *
+     * One BFS per node, run in parallel over the nodes. Each neighbour of
+     * the start node labels its own subtree, and the first edge joining
+     * two subtrees closes the shortest cycle through the start node. The
+     * BFS ends at that level, so its cost only grows with the local girth.
+     *
+     * @param H Parity-check matrix
+     * @param checks Start from the check nodes instead of the variable nodes
+     * @return vec_int Local girth of each node, 0 if it is on no cycle
+     */
+    vec_int local_girth(const sparse_csr<bits_t> &H, const bool checks = false);
+
+    /**
+     * @brief Count the cycles of length 4, 6, ..., maxLength.
+     *
+     * Each cycle is counted from its variable node of least index, in
+     * parallel over the variable nodes.
+     *
+     * @param H Parity-check matrix
+     * @param maxLength Longest cycle length counted
+     * @return std::vector<u64> Number of cycles of each length
+     */
+    std::vector<u64> count_cycles(const sparse_csr<bits_t> &H, const int maxLength = 8);
+
+    /**
+     * @brief Variable nodes of every cycle of length 4, 6, ..., maxLength.
+     *
+     * @param varN Check node neighbours of the variable nodes
+     * @param checkN Variable node neighbours of the check nodes
+     * @param maxLength Longest cycle length
+     * @return std::vector<vec_int> Ascending variable nodes of each cycle
+     */
+    std::vector<vec_int> find_cycles(const std::vector<std::vector<node>> &varN, const std::vector<std::vector<node>> &checkN, const int maxLength);
+
+    /**
+     * @brief Girth, local girths and number of 4-, 6- and 8-cycles.
+     *
+     * @param H Parity-check matrix
+     * @param maxLength Longest cycle length counted
+     * @return cycle_spectrum Cycle statistics
+     */
+    cycle_spectrum analyze_cycles(const sparse_csr<bits_t> &H, const int maxLength = 8);
+
+    std::ostream &operator<<(std::ostream &os, const cycle_spectrum &s);
+} // namespace ldpc
@@ -0,0 +1,712 @@
+#include "density_evolution.h"
+
+#include <complex>
+#include <limits>
+
+namespace ldpc
+{
+    namespace
+    {
+        enum class de_channel
+        {
+            AWGN,
+            BSC,
+            BEC
+        };
+
+        de_channel channel_of(const de_param &param)
+        {
+            const std::string c(param.channel ? param.channel : "");
+            if (c == "AWGN")
+                return de_channel::AWGN;
+            if (c == "BSC")
+                return de_channel::BSC;
+            if (c == "BEC")
+                return de_channel::BEC;
+            throw std::runtime_error("density evolution: unknown channel " + c);
+        }
+
+        bool is_minsum(const de_param &param)
+        {
+            const std::string d(param.decoding ? param.decoding : "");
+            if (d == "BP")
+                return false;
+            if (d == "BP_MS")
+                return true;
+            throw std::runtime_error("density evolution: unknown decoding " + d);
+        }
+
+        bool is_discretized(const de_param &param)
+        {
+            const std::string m(param.method ? param.method : "");
+            if (m == "GA")
+                return false;
+            if (m == "DDE")
+                return true;
+            throw std::runtime_error("density evolution: unknown method " + m);
+        }
+
+        double coefficient(const vec_double_t &dist, const int d)
+        {
+            return (d < static_cast<int>(dist.size())) ? dist[d] : 0.0;
+        }
+
+        // largest variable degree of either class
+        int max_var_degree(const degree_distribution &dist)
+        {
+            return std::max(dist.lambda.size(), dist.lambdaPunctured.size()) - 1;
+        }
+
+        // clear the round-off of the FFT, whose mass loss would grow by the degrees each iteration
+        void normalize(vec_double_t &p)
+        {
+            double mass = 0;
+            for (auto &x : p)
+            {
+                x = std::max(x, 0.0);
+                mass += x;
+            }
+            for (auto &x : p)
+                x /= mass;
+        }
+
+        /**
+         * @brief Ends the evolution once the error reaches the target, or
+         * once it has not dropped by a fraction STALL in STALL_WINDOW
+         * iterations, as it need not drop in every iteration.
+         */
+        class convergence
+        {
+        public:
+            explicit convergence(const double target) : mTarget(target) {}
+
+            bool done(const double err)
+            {
+                if (err < mTarget)
+                    return true;
+                if (err < mBest * (1 - STALL))
+                {
+                    mBest = err;
+                    mSince = 0;
+                    return false;
+                }
+                return ++mSince >= STALL_WINDOW;
+            }
+
+        private:
+            static constexpr double STALL = 1e-7;
+            static constexpr u32 STALL_WINDOW = 10;
+
+            double mTarget;
+            double mBest = std::numeric_limits<double>::infinity();
+            u32 mSince = 0;
+        };
+
+        // P(X > x) of a standard normal X
+        double q_function(const double x) { return 0.5 * std::erfc(x / std::sqrt(2.0)); }
+
+        double q_inverse(const double p)
+        {
+            double lo = -40, hi = 40;
+            for (int k = 0; k < 200; ++k)
+            {
+                const double mid = (lo + hi) / 2;
+                (q_function(mid) > p ? lo : hi) = mid;
+            }
+            return (lo + hi) / 2;
+        }
+
+        /**
+         * @brief Erasure probability of the messages on the BEC, exact.
+         */
+        double bec_error(const degree_distribution &dist, const de_param &param, const double epsilon)
+        {
+            const int dv = max_var_degree(dist);
+
+            // check-to-variable erasure probability, all erased at first
+            convergence conv(param.targetError);
+            double y = 1;
+            double x = 1;
+            for (u32 it = 0; it < param.iterations; ++it)
+            {
+                x = 0;
+                for (int d = 1; d <= dv; ++d)
+                    x += (coefficient(dist.lambda, d) * epsilon + coefficient(dist.lambdaPunctured, d)) * std::pow(y, d - 1);
+
+                if (conv.done(x))
+                    break;
+
+                y = 0;
+                for (u64 j = 1; j < dist.rho.size(); ++j)
+                    y += dist.rho[j] * (1 - std::pow(1 - x, j - 1));
+            }
+            return x;
+        }
+
+        // E[tanh(L/2)] = 1 - phi(m) of a symmetric Gaussian of mean m (Chung et al.)
+        double phi(const double x)
+        {
+            if (x <= 0)
+                return 1.0;
+            if (x < 10)
+                return std::min(1.0, std::exp(-0.4527 * std::pow(x, 0.86) + 0.0218));
+            return std::sqrt(M_PI / x) * std::exp(-x / 4) * (1 - 10 / (7 * x));
+        }
+
+        double phi_inverse(const double y)
+        {
+            if (y >= 1)
+                return 0;
+            if (y >= phi(10))
+                return std::pow((0.0218 - std::log(y)) / 0.4527, 1 / 0.86);
+
+            double lo = 10, hi = 20;
+            while (phi(hi) > y && hi < 1e5)
+                hi *= 2;
+            for (int k = 0; k < 100; ++k)
+            {
+                const double mid = (lo + hi) / 2;
+                (phi(mid) > y ? lo : hi) = mid;
+            }
+            return (lo + hi) / 2;
+        }
+
+        /**
+         * @brief Mean of the messages in the Gaussian approximation, the
+         * variance of a symmetric Gaussian is twice its mean.
+         */
+        double ga_error(const degree_distribution &dist, const de_param &param, const de_channel channel, const double channelParam)
+        {
+            if (is_minsum(param))
+                throw std::runtime_error("density evolution: GA only models BP, use DDE for min-sum");
+
+            double mch;
+            if (channel == de_channel::AWGN)
+                mch = 2 * std::pow(10, channelParam / 10);
+            else
+                mch = 2 * std::pow(q_inverse(channelParam), 2);
+
+            const int dv = max_var_degree(dist);
+            auto error = [&](const double mu) {
+                double e = 0;
+                for (int d = 1; d <= dv; ++d)
+                {
+                    e += coefficient(dist.lambda, d) * q_function(std::sqrt((mch + (d - 1) * mu) / 2));
+                    e += coefficient(dist.lambdaPunctured, d) * q_function(std::sqrt((d - 1) * mu / 2));
+                }
+                return e;
+            };
+
+            // mean of the check-to-variable messages
+            convergence conv(param.targetError);
+            double mu = 0;
+            double err = error(mu);
+            for (u32 it = 0; it < param.iterations && !conv.done(err); ++it)
+            {
+                double s = 0;
+                for (int d = 1; d <= dv; ++d)
+                {
+                    s += coefficient(dist.lambda, d) * phi(mch + (d - 1) * mu);
+                    s += coefficient(dist.lambdaPunctured, d) * phi((d - 1) * mu);
+                }
+
+                double next = 0;
+                for (u64 j = 1; j < dist.rho.size(); ++j)
+                {
+                    // 1 - (1 - s)^(j - 1) without cancellation for small s
+                    if (dist.rho[j] > 0)
+                        next += dist.rho[j] * phi_inverse(-std::expm1((j - 1) * std::log1p(-s)));
+                }
+
+                mu = next;
+                err = error(mu);
+            }
+            return err;
+        }
+
+        /**
+         * @brief Radix-2 complex FFT of a fixed power-of-two size.
+         */
+        class fft_plan
+        {
+        public:
+            explicit fft_plan(const int size)
+                : mSize(size), mTwiddle(size / 2), mRev(size, 0)
+            {
+                for (int k = 0; k < size / 2; ++k)
+                    mTwiddle[k] = std::polar(1.0, -2 * M_PI * k / size);
+
+                for (int i = 1, j = 0; i < size; ++i)
+                {
+                    int bit = size >> 1;
+                    for (; j & bit; bit >>= 1)
+                        j ^= bit;
+                    j ^= bit;
+                    mRev[i] = j;
+                }
+            }
+
+            void transform(std::vector<std::complex<double>> &a, const bool inverse) const
+            {
+                for (int i = 0; i < mSize; ++i)
+                {
+                    if (i < mRev[i])
+                        std::swap(a[i], a[mRev[i]]);
+                }
+
+                for (int len = 2; len <= mSize; len <<= 1)
+                {
+                    const int step = mSize / len;
+                    for (int i = 0; i < mSize; i += len)
+                    {
+                        for (int k = 0; k < len / 2; ++k)
+                        {
+                            const auto w = inverse ? std::conj(mTwiddle[k * step]) : mTwiddle[k * step];
+                            const auto t = w * a[i + k + len / 2];
+                            a[i + k + len / 2] = a[i + k] - t;
+                            a[i + k] += t;
+                        }
+                    }
+                }
+
+                if (inverse)
+                {
+                    for (auto &x : a)
+                        x /= mSize;
+                }
+            }
+
+            int size() const { return mSize; }
+
+        private:
+            int mSize;
+            std::vector<std::complex<double>> mTwiddle;
+            vec_int mRev;
+        };
+
+        /**
+         * @brief Linear convolution of densities on a grid of n bins, the
+         * mass beyond the grid saturates in its first and last bin.
+         */
+        class grid_convolution
+        {
+        public:
+            using spectrum = std::vector<std::complex<double>>;
+
+            // shift is the bin of value zero of the inputs, i.e. bin r of the sum goes to r - shift
+            grid_convolution(const int n, const int shift)
+                : mN(n), mShift(shift), mPlan(fft_size(n)), mBuffer(mPlan.size()) {}
+
+            spectrum transform(const vec_double_t &a)
+            {
+                spectrum s(mPlan.size(), 0.0);
+                std::copy(a.begin(), a.end(), s.begin());
+                mPlan.transform(s, false);
+                return s;
+            }
+
+            void apply(const vec_double_t &a, const spectrum &b, vec_double_t &out)
+            {
+                std::fill(mBuffer.begin(), mBuffer.end(), 0.0);
+                std::copy(a.begin(), a.end(), mBuffer.begin());
+                mPlan.transform(mBuffer, false);
+                for (int k = 0; k < mPlan.size(); ++k)
+                    mBuffer[k] *= b[k];
+                mPlan.transform(mBuffer, true);
+
+                out.assign(mN, 0.0);
+                for (int r = 0; r < 2 * mN - 1; ++r)
+                    out[std::clamp(r - mShift, 0, mN - 1)] += mBuffer[r].real();
+            }
+
+            // two convolutions of real densities in one transform each way, a
+            // in the real and b in the imaginary part
+            void apply_pair(const vec_double_t &a, const spectrum &sa, const vec_double_t &b, const spectrum &sb, vec_double_t &outA, vec_double_t &outB)
+            {
+                std::fill(mBuffer.begin(), mBuffer.end(), 0.0);
+                for (int i = 0; i < mN; ++i)
+                    mBuffer[i] = {a[i], b[i]};
+                mPlan.transform(mBuffer, false);
+
+                // by conjugate symmetry, a has the spectrum (X[k] + X*[-k]) / 2 and
+                // i b the spectrum (X[k] - X*[-k]) / 2, each pair is done in place
+                const int size = mPlan.size();
+                for (int k = 0; k <= size / 2; ++k)
+                {
+                    const int l = (size - k) % size;
+                    const auto xk = mBuffer[k], xl = mBuffer[l];
+                    mBuffer[k] = 0.5 * ((xk + std::conj(xl)) * sa[k] + (xk - std::conj(xl)) * sb[k]);
+                    mBuffer[l] = 0.5 * ((xl + std::conj(xk)) * sa[l] + (xl - std::conj(xk)) * sb[l]);
+                }
+                mPlan.transform(mBuffer, true);
+
+                outA.assign(mN, 0.0);
+                outB.assign(mN, 0.0);
+                for (int r = 0; r < 2 * mN - 1; ++r)
+                {
+                    const int k = std::clamp(r - mShift, 0, mN - 1);
+                    outA[k] += mBuffer[r].real();
+                    outB[k] += mBuffer[r].imag();
+                }
+            }
+
+        private:
+            static int fft_size(const int n)
+            {
+                int size = 1;
+                while (size < 2 * n - 1)
+                    size <<= 1;
+                return size;
+            }
+
+            int mN;
+            int mShift;
+            fft_plan mPlan;
+            spectrum mBuffer;
+        };
+
+        /**
+         * @brief Density evolution of quantized LLR densities.
+         *
+         * LLR bin i holds the value (i - K) * delta. The BP check node works
+         * on G(L) = (sign L, -log tanh(|L|/2)), where the check node sums
+         * the second part and adds the signs, i.e. it convolves the sum and
+         * difference of the densities of both signs.
+         */
+        class discretized_evolution
+        {
+        public:
+            discretized_evolution(const degree_distribution &dist, const de_param &param)
+                : mDist(dist),
+                  mParam(param),
+                  mMinSum(is_minsum(param)),
+                  mK(param.bins),
+                  mN(2 * param.bins + 1),
+                  mDelta(param.maxLlr / param.bins),
+                  mM(2 * param.bins),
+                  mLlrConv(mN, mK),
+                  mYConv(mM, 0),
+                  mYOf(mK + 1),
+                  mAOf(mM)
+            {
+                if (param.bins < 2 || param.maxLlr <= 0)
+                    throw std::runtime_error("density evolution: invalid quantization");
+
+                // -log tanh(x/2) is its own inverse; the last bin holds the LLRs
+                // below delta/2, the first the large ones, which come back finite
+                // since a saturated message of the wrong sign could never recover
+                const double yMax = -std::log(std::tanh(mDelta / 4));
+                const double yDelta = yMax / (mM - 1);
+                mYOf[0] = mM - 1;
+                for (int a = 1; a <= mK; ++a)
+                    mYOf[a] = std::min<long>(mM - 1, std::lround(-std::log(std::tanh(a * mDelta / 2)) / yDelta));
+                mAOf[0] = std::min<long>(mK, std::lround(-std::log(std::tanh(yDelta / 8)) / mDelta));
+                for (int j = 1; j < mM; ++j)
+                    mAOf[j] = std::min<long>(mK, std::lround(-std::log(std::tanh(j * yDelta / 2)) / mDelta));
+            }
+
+            double run(const de_channel channel, const double channelParam)
+            {
+                vec_double_t ch(mN, 0.0);
+                if (channel == de_channel::AWGN)
+                {
+                    // LLR of BPSK with noise variance sigma^2 is N(2/sigma^2, 4/sigma^2)
+                    const double sigma2 = std::pow(10, -channelParam / 10);
+                    const double mean = 2 / sigma2;
+                    const double sd = 2 / std::sqrt(sigma2);
+                    for (int i = 0; i < mN; ++i)
+                    {
+                        const double upper = (i == mN - 1) ? 1.0 : 1 - q_function(((i - mK + 0.5) * mDelta - mean) / sd);
+                        const double lower = (i == 0) ? 0.0 : 1 - q_function(((i - mK - 0.5) * mDelta - mean) / sd);
+                        ch[i] = upper - lower;
+                    }
+                }
+                else
+                {
+                    const int a = std::min<long>(mK, std::lround(std::log((1 - channelParam) / channelParam) / mDelta));
+                    ch[mK + a] += 1 - channelParam;
+                    ch[mK - a] += channelParam;
+                }
+                mChannel = mLlrConv.transform(ch);
+
+                // no check messages yet
+                vec_double_t c(mN, 0.0), v;
+                c[mK] = 1;
+
+                convergence conv(mParam.targetError);
+                double err = 1;
+                for (u32 it = 0; it < mParam.iterations; ++it)
+                {
+                    variable_update(c, v);
+
+                    err = error(v);
+                    if (conv.done(err))
+                        break;
+
+                    if (mMinSum)
+                        check_update_minsum(v, c);
+                    else
+                        check_update_bp(v, c);
+                }
+                return err;
+            }
+
+        private:
+            // P(L < 0) + P(L = 0) / 2
+            double error(const vec_double_t &v) const
+            {
+                double e = 0.5 * v[mK];
+                for (int i = 0; i < mK; ++i)
+                    e += v[i];
+                return e;
+            }
+
+            void variable_update(const vec_double_t &c, vec_double_t &v)
+            {
+                // powers of c, the transmitted classes are convolved with the channel at once
+                const auto spec = mLlrConv.transform(c);
+                vec_double_t power(mN, 0.0), next;
+                power[mK] = 1;
+
+                vec_double_t transmitted(mN, 0.0);
+                v.assign(mN, 0.0);
+                const int dv = max_var_degree(mDist);
+                for (int d = 1; d <= dv; ++d)
+                {
+                    if (d == 2)
+                    {
+                        power = c;
+                    }
+                    else if (d > 2)
+                    {
+                        mLlrConv.apply(power, spec, next);
+                        std::swap(power, next);
+                    }
+
+                    const double w = coefficient(mDist.lambda, d);
+                    const double wp = coefficient(mDist.lambdaPunctured, d);
+                    for (int i = 0; i < mN; ++i)
+                    {
+                        transmitted[i] += w * power[i];
+                        v[i] += wp * power[i];
+                    }
+                }
+
+                mLlrConv.apply(transmitted, mChannel, next);
+                for (int i = 0; i < mN; ++i)
+                    v[i] += next[i];
+                normalize(v);
+            }
+
+            void check_update_bp(const vec_double_t &v, vec_double_t &c)
+            {
+                // sum and difference of the densities of positive and negative sign
+                vec_double_t s(mM, 0.0), d(mM, 0.0);
+                s[mM - 1] = v[mK];
+                for (int a = 1; a <= mK; ++a)
+                {
+                    s[mYOf[a]] += v[mK + a] + v[mK - a];
+                    d[mYOf[a]] += v[mK + a] - v[mK - a];
+                }
+                const auto sSpec = mYConv.transform(s);
+                const auto dSpec = mYConv.transform(d);
+
+                // degree j sees j - 1 inputs, none for j = 1
+                vec_double_t ps(mM, 0.0), pd(mM, 0.0);
+                ps[0] = pd[0] = 1;
+                vec_double_t accS(mM, 0.0), accD(mM, 0.0);
+                for (u64 j = 1; j < mDist.rho.size(); ++j)
+                {
+                    if (j == 2)
+                    {
+                        ps = s;
+                        pd = d;
+                    }
+                    else if (j > 2)
+                    {
+                        mYConv.apply_pair(ps, sSpec, pd, dSpec, ps, pd);
+                    }
+
+                    for (int k = 0; k < mM; ++k)
+                    {
+                        accS[k] += mDist.rho[j] * ps[k];
+                        accD[k] += mDist.rho[j] * pd[k];
+                    }
+                }
+
+                c.assign(mN, 0.0);
+                for (int k = 0; k < mM; ++k)
+                {
+                    c[mK + mAOf[k]] += (accS[k] + accD[k]) / 2;
+                    c[mK - mAOf[k]] += (accS[k] - accD[k]) / 2;
+                }
+                normalize(c);
+            }
+
+            void check_update_minsum(const vec_double_t &v, vec_double_t &c)
+            {
+                // mass of magnitude at least a, by sign
+                vec_double_t plus(mK + 2, 0.0), minus(mK + 2, 0.0);
+                for (int a = mK; a >= 1; --a)
+                {
+                    plus[a] = plus[a + 1] + v[mK + a];
+                    minus[a] = minus[a + 1] + v[mK - a];
+                }
+
+                // of k iid inputs, the minimum magnitude is at least a with probability
+                // (plus + minus)^k, and the sign is positive with an even number of negatives
+                c.assign(mN, 0.0);
+                vec_double_t up(mK + 2, 0.0), um(mK + 2, 0.0);
+                for (u64 j = 1; j < mDist.rho.size(); ++j)
+                {
+                    if (mDist.rho[j] == 0)
+                        continue;
+
+                    const int k = j - 1;
+                    for (int a = 1; a <= mK; ++a)
+                    {
+                        const double all = std::pow(plus[a] + minus[a], k);
+                        const double diff = std::pow(plus[a] - minus[a], k);
+                        up[a] = (all + diff) / 2;
+                        um[a] = (all - diff) / 2;
+                    }
+
+                    for (int a = 1; a <= mK; ++a)
+                    {
+                        c[mK + a] += mDist.rho[j] * (up[a] - up[a + 1]);
+                        c[mK - a] += mDist.rho[j] * (um[a] - um[a + 1]);
+                    }
+                    c[mK] += mDist.rho[j] * (1 - up[1] - um[1]);
+                }
+                normalize(c);
+            }
+
+            const degree_distribution &mDist;
+            const de_param &mParam;
+            bool mMinSum;
+
+            int mK;
+            int mN;
+            double mDelta;
+            int mM;
+
+            grid_convolution mLlrConv;
+            grid_convolution mYConv;
+            grid_convolution::spectrum mChannel;
+
+            // bin of -log tanh(|L|/2) of each LLR magnitude bin, and back
+            vec_int mYOf;
+            vec_int mAOf;
+        };
+    } // namespace
+
+    degree_distribution degree_distribution_of(const ldpc_code &code)
+    {
+        const double edges = code.nnz_graph();
+        if (edges == 0)
+            throw std::runtime_error("degree_distribution_of: empty decoding graph");
+
+        std::vector<bool> isPunctured(code.nc(), false);
+        for (auto p : code.puncture())
+            isPunctured[p] = true;
+
+        // edges on nodes of each degree, normalized at the end
+        auto add = [](vec_double_t &dist, const u64 d) {
+            if (dist.size() <= d)
+                dist.resize(d + 1, 0.0);
+            dist[d] += d;
+        };
+
+        degree_distribution dist;
+        for (int j = 0; j < code.nc(); ++j)
+        {
+            const auto d = code.var_neighbor()[j].size();
+            if (d > 0)
+                add(isPunctured[j] ? dist.lambdaPunctured : dist.lambda, d);
+        }
+        for (const auto &cn : code.check_neighbor())
+        {
+            if (!cn.empty())
+                add(dist.rho, cn.size());
+        }
+
+        for (auto *d : {&dist.lambda, &dist.lambdaPunctured, &dist.rho})
+        {
+            for (auto &x : *d)
+                x /= edges;
+        }
+        return dist;
+    }
+
+    double de_error(const degree_distribution &dist, const de_param &param, const double channelParam)
+    {
+        const auto channel = channel_of(param);
+        const bool discretized = is_discretized(param);
+        is_minsum(param); // rejects an unknown decoding on the BEC too
+
+        if (channel == de_channel::BEC)
+            return bec_error(dist, param, channelParam);
+        if (!discretized)
+            return ga_error(dist, param, channel, channelParam);
+
+        discretized_evolution de(dist, param);
+        return de.run(channel, channelParam);
+    }
+
+    double de_threshold(const degree_distribution &dist, const de_param &param)
+    {
+        const auto channel = channel_of(param);
+        const bool awgn = (channel == de_channel::AWGN);
+        const bool minsum = is_minsum(param);
+
+        // search range of the SNR in dB, or of the crossover or erasure probability
+        const double best = awgn ? 20.0 : 1e-6;
+        const double worst = awgn ? -10.0 : ((channel == de_channel::BSC) ? 0.5 : 1.0);
+
+        std::unique_ptr<discretized_evolution> de;
+        if (is_discretized(param) && channel != de_channel::BEC)
+            de = std::make_unique<discretized_evolution>(dist, param);
+
+        auto converges = [&](const double x) {
+            const double err = de ? de->run(channel, x) : de_error(dist, param, x);
+            return err < param.targetError;
+        };
+
+        double good = best, bad = worst;
+        if (de)
+        {
+            // bracket the threshold around the GA one, min-sum is worse than BP
+            auto gaParam = param;
+            gaParam.method = "GA";
+            gaParam.decoding = "BP";
+            const double ga = de_threshold(dist, gaParam);
+            if (!std::isnan(ga))
+            {
+                good = awgn ? std::min(best, ga + (minsum ? 2.0 : 0.5)) : std::max(best, ga * (minsum ? 0.5 : 0.8));
+                bad = awgn ? std::max(worst, ga - 0.5) : std::min(worst, ga * 1.2);
+            }
+        }
+
+        // widen the bracket towards the search range
+        while (!converges(good))
+        {
+            if (good == best)
+                return std::numeric_limits<double>::quiet_NaN();
+            good = awgn ? std::min(best, good + 2.0) : std::max(best, good / 2);
+        }
+        while (bad != worst && converges(bad))
+        {
+            good = bad;
+            bad = awgn ? std::max(worst, bad - 2.0) : std::min(worst, bad * 1.5);
+        }
+        if (bad == worst && converges(bad))
+            return worst;
+
+        while (std::abs(good - bad) > param.tolerance)
+        {
+            const double mid = (good + bad) / 2;
+            (converges(mid) ? good : bad) = mid;
+        }
+        return good;
+    }
+} // namespace ldpc
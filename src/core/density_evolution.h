@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ldpc.h"
+
+namespace ldpc
+{
+    struct
+    {
+        const char *method;   // "GA" (Gaussian approximation) or "DDE" (discretized)
+        const char *decoding; // "BP" or "BP_MS"
+        const char *channel;  // "AWGN", "BSC" or "BEC"
+        u32 iterations;       // most decoding iterations per channel parameter
+        u32 bins;             // DDE: quantization bins per sign of the LLR
+        double maxLlr;        // DDE: largest LLR magnitude, larger ones saturate
+        double targetError;   // error probability of the messages taken as converged
+        double tolerance;     // precision of the threshold, in dB or probability
+    } typedef de_param;
+
+    /**
+     * @brief Edge-perspective degree distribution, i.e. the fraction of
+     * edges on nodes of each degree, indexed by the degree. Punctured
+     * variable nodes form their own classes, they see no channel.
+     */
+    struct degree_distribution
+    {
+        vec_double_t lambda;          // transmitted variable nodes
+        vec_double_t lambdaPunctured; // punctured variable nodes
+        vec_double_t rho;             // check nodes
+    };
+
+    /**
+     * @brief Degree distribution of the decoding graph of a code, i.e.
+     * without shortened bits and pruned punctured bits.
+     *
+     * @param code LDPC code
+     * @return degree_distribution Edge-perspective degree distribution
+     */
+    degree_distribution degree_distribution_of(const ldpc_code &code);
+
+    /**
+     * @brief Error probability of the variable-to-check messages after
+     * density evolution of the ensemble.
+     *
+     * On the BEC, the erasure probability is tracked exactly, for BP and
+     * min-sum alike. Otherwise, GA tracks the mean of symmetric Gaussian
+     * messages (Chung et al.) and only models BP; on the BSC, the channel
+     * Gaussian has the crossover probability as error probability. DDE
+     * tracks the quantized LLR densities: the variable node convolves them
+     * by FFT, the BP check node convolves their sign and -log tanh(|L|/2)
+     * parts by FFT, and the min-sum check node takes the minimum of iid
+     * magnitudes in closed form. Evolution stops once the error reaches
+     * targetError or stalls.
+     *
+     * @throw runtime_error on an unknown method, decoding or channel
+     * @param dist Degree distribution
+     * @param param Evolution parameters
+     * @param channelParam SNR in dB as in ldpcsim, i.e. sigma^2 = 10^(-SNR/10), or crossover or erasure probability
+     * @return double Error probability
+     */
+    double de_error(const degree_distribution &dist, const de_param &param, const double channelParam);
+
+    /**
+     * @brief Decoding threshold of the ensemble, found by bisection on
+     * the channel parameter. A DDE search on AWGN or BSC starts from the
+     * bracket around the GA threshold.
+     *
+     * @throw runtime_error on an unknown method, decoding or channel
+     * @param dist Degree distribution
+     * @param param Evolution parameters
+     * @return double Least SNR in dB, or largest crossover or erasure probability,
+     *         that converges; NaN if none in the search range does
+     */
+    double de_threshold(const degree_distribution &dist, const de_param &param);
+} // namespace ldpc
@@ -0,0 +1,120 @@
+#include "distance.h"
+#include "bit_matrix.h"
+
+#include <numeric>
+#include <set>
+
+namespace ldpc
+{
+    min_distance estimate_min_distance(const sparse_csr<bits_t> &H, const distance_param &param)
+    {
+        if (param.p < 1 || param.p > 2)
+            throw std::runtime_error("estimate_min_distance: p must be 1 or 2");
+
+        const int n = H.num_cols();
+        std::mt19937_64 rng(param.seed);
+
+        // column j of the shuffled H is column order[j] of H
+        vec_int order(n);
+        std::iota(order.begin(), order.end(), 0);
+        vec_int position(n);
+
+        int best = n + 1;
+        std::set<vec_int> found;
+
+        for (u32 it = 0; it < param.iterations; ++it)
+        {
+            std::shuffle(order.begin(), order.end(), rng);
+            for (int j = 0; j < n; ++j)
+                position[order[j]] = j;
+
+            std::vector<edge<bits_t>> edges;
+            edges.reserve(H.nz_entry().size());
+            for (const auto &e : H.nz_entry())
+                edges.push_back(edge<bits_t>({e.rowIndex, position[e.colIndex], e.value}));
+
+            vec_int perm;
+            const auto G = generator_matrix(sparse_csr<bits_t>(H.num_rows(), n, edges), perm, -1);
+            const int k = G.num_rows();
+            const int words = G.num_words();
+
+            auto weight = [&](const u64 *a, const u64 *b) {
+                int w = 0;
+                for (int i = 0; i < words; ++i)
+                    w += __builtin_popcountl(b ? a[i] ^ b[i] : a[i]);
+                return w;
+            };
+
+            // rows and pairs of the least weight of this iteration, if not above the best so far
+            int least = best;
+            std::vector<std::pair<int, int>> candidates;
+            #pragma omp parallel
+            {
+                int localLeast = best;
+                std::vector<std::pair<int, int>> local;
+                auto consider = [&](const int w, const int i, const int j) {
+                    if (w < localLeast)
+                    {
+                        localLeast = w;
+                        local.clear();
+                    }
+                    if (w == localLeast)
+                        local.push_back(std::make_pair(i, j));
+                };
+
+                #pragma omp for schedule(dynamic, 16)
+                for (int i = 0; i < k; ++i)
+                {
+                    consider(weight(G.row(i), nullptr), i, -1);
+                    if (param.p < 2)
+                        continue;
+
+                    for (int j = i + 1; j < k; ++j)
+                        consider(weight(G.row(i), G.row(j)), i, j);
+                }
+
+                #pragma omp critical
+                {
+                    if (localLeast < least)
+                    {
+                        least = localLeast;
+                        candidates.clear();
+                    }
+                    if (localLeast == least)
+                        candidates.insert(candidates.end(), local.begin(), local.end());
+                }
+            }
+
+            for (const auto &c : candidates)
+            {
+                vec_int support;
+                const u64 *a = G.row(c.first);
+                const u64 *b = (c.second >= 0) ? G.row(c.second) : nullptr;
+                for (int w = 0; w < words; ++w)
+                {
+                    for (u64 bits = b ? a[w] ^ b[w] : a[w]; bits != 0; bits &= bits - 1)
+                        support.push_back(order[w * 64 + __builtin_ctzl(bits)]);
+                }
+                std::sort(support.begin(), support.end());
+
+                const int w = support.size();
+                if (w < best)
+                {
+                    best = w;
+                    found.clear();
+                }
+                if (w == best)
+                    found.insert(support);
+            }
+        }
+
+        min_distance result;
+        if (!found.empty())
+        {
+            result.dmin = best;
+            result.multiplicity = found.size();
+            result.codewords.assign(found.begin(), found.end());
+        }
+        return result;
+    }
+} // namespace ldpc
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "functions.h"
+
+namespace ldpc
+{
+    struct
+    {
+        u64 seed;
+        u32 iterations; // random information sets
+        u32 p;          // rows of G combined per candidate, 1 or 2
+    } typedef distance_param;
+
+    /**
+     * @brief Low-weight codewords found by a minimum distance search.
+     */
+    struct min_distance
+    {
+        int dmin = 0;                   // least weight found, an upper bound on the minimum distance
+        u64 multiplicity = 0;           // distinct codewords of weight dmin found, a lower bound
+        std::vector<vec_int> codewords; // support of each codeword of weight dmin found, ascending
+    };
+
+    /**
+     * @brief Estimate the minimum distance by information-set search
+     * (Lee-Brickell).
+     *
+     * Every iteration draws a random column order and derives a systematic
+     * generator matrix on the information set it yields, as bit-packed rows
+     * of the dense echelon form. Low-weight codewords likely have few bits
+     * in a random information set, so all rows and, with p = 2, all sums of
+     * two rows are checked, in parallel over the rows.
+     *
+     * @throw runtime_error if H has full column rank
+     * @param H Parity-check matrix
+     * @param param Search parameters
+     * @return min_distance Least weight, multiplicity and codewords found
+     */
+    min_distance estimate_min_distance(const sparse_csr<bits_t> &H, const distance_param &param);
+} // namespace ldpc
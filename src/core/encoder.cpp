@@ -0,0 +1,416 @@
+#include "encoder.h"
+
+namespace ldpc
+{
+    packed_encoder::packed_encoder(const sparse_csr<bits_t> &G, const vec_int &infoPos)
+        : mK(G.num_rows()),
+          mN(G.num_cols()),
+          mWords((G.num_rows() + 63) / 64),
+          mInfoPos(infoPos)
+    {
+        std::vector<bool> isInfo(mN, false);
+        for (auto p : mInfoPos)
+        {
+            isInfo[p] = true;
+        }
+
+        for (int j = 0; j < mN; ++j)
+        {
+            if (isInfo[j])
+                continue;
+
+            mParityPos.push_back(j);
+            mParity.resize(mParity.size() + mWords, 0);
+            mParityN.push_back(vec_int());
+
+            auto row = mParity.end() - mWords;
+            for (const auto &n : G.col_neighbor()[j])
+            {
+                if (G.nz_entry()[n.edgeIndex].value.value == 0)
+                    continue;
+
+                row[n.nodeIndex / 64] ^= u64(1) << (n.nodeIndex % 64);
+                mParityN.back().push_back(n.nodeIndex);
+            }
+        }
+    }
+
+    void packed_encoder::encode(const vec_bits_t &u, vec_bits_t &c) const
+    {
+        vec_u64 packed(mWords, 0);
+        for (int i = 0; i < mK; ++i)
+        {
+            packed[i / 64] |= u64(u[i].value) << (i % 64);
+        }
+
+        for (int i = 0; i < static_cast<int>(mInfoPos.size()); ++i)
+        {
+            c[mInfoPos[i]] = u[i];
+        }
+
+        auto row = mParity.begin();
+        for (auto j : mParityPos)
+        {
+            u64 acc = 0;
+            for (int w = 0; w < mWords; ++w)
+            {
+                acc ^= packed[w] & row[w];
+            }
+            c[j] = __builtin_parityl(acc);
+            row += mWords;
+        }
+    }
+
+    vec_bits_t packed_encoder::encode(const vec_bits_t &u) const
+    {
+        vec_bits_t c(mN);
+        encode(u, c);
+        return c;
+    }
+
+    void packed_encoder::encode_sliced(const vec_u64 &u, vec_u64 &c) const
+    {
+        for (int i = 0; i < static_cast<int>(mInfoPos.size()); ++i)
+        {
+            c[mInfoPos[i]] = u[i];
+        }
+
+        for (u64 j = 0; j < mParityPos.size(); ++j)
+        {
+            u64 acc = 0;
+            for (auto i : mParityN[j])
+            {
+                acc ^= u[i];
+            }
+            c[mParityPos[j]] = acc;
+        }
+    }
+
+    void packed_encoder::save(binary_writer &out) const
+    {
+        out.put(mK);
+        out.put(mN);
+        out.put(mWords);
+        out.put(mInfoPos);
+        out.put(mParityPos);
+        out.put(mParity);
+        out.put(mParityN);
+    }
+
+    void packed_encoder::load(binary_reader &in)
+    {
+        in.get(mK);
+        in.get(mN);
+        in.get(mWords);
+        in.get(mInfoPos);
+        in.get(mParityPos);
+        in.get(mParity);
+        in.get(mParityN);
+    }
+
+    h_encoder::h_encoder(const sparse_csr<bits_t> &H)
+        : mN(H.num_cols()),
+          mRows(H.num_rows())
+    {
+        const int m = H.num_rows();
+        const int k = mN - m;
+        if (k < 0)
+            throw std::runtime_error("h_encoder(): more checks than bits");
+
+        for (int i = 0; i < m; ++i)
+        {
+            for (const auto &n : H.row_neighbor()[i])
+                mRows[i].push_back(n.nodeIndex);
+        }
+
+        // residual degree of each check in the unknown parity bits
+        vec_int degree(m, 0);
+        std::vector<bool> known(mN, false);
+        std::vector<bool> rowDone(m, false);
+        for (int j = 0; j < k; ++j)
+            known[j] = true;
+        for (int i = 0; i < m; ++i)
+        {
+            for (auto j : mRows[i])
+                degree[i] += !known[j];
+        }
+
+        vec_int single;
+        for (int i = 0; i < m; ++i)
+        {
+            if (degree[i] == 1)
+                single.push_back(i);
+        }
+
+        auto resolve = [&](const int j) {
+            known[j] = true;
+            for (const auto &n : H.col_neighbor()[j])
+            {
+                if (--degree[n.nodeIndex] == 1 && !rowDone[n.nodeIndex])
+                    single.push_back(n.nodeIndex);
+            }
+        };
+
+        int unknown = m;
+        while (unknown > 0)
+        {
+            if (!single.empty())
+            {
+                auto i = single.back();
+                single.pop_back();
+                if (rowDone[i] || degree[i] != 1)
+                    continue;
+
+                auto j = *std::find_if(mRows[i].begin(), mRows[i].end(), [&known](const int c) { return !known[c]; });
+                rowDone[i] = true;
+                mTriangular.push_back(std::make_pair(i, j));
+                resolve(j);
+                --unknown;
+                continue;
+            }
+
+            // stuck, all but one unknown bit of a check of least degree become gap bits
+            int best = -1;
+            for (int i = 0; i < m; ++i)
+            {
+                if (!rowDone[i] && degree[i] > 1 && (best < 0 || degree[i] < degree[best]))
+                    best = i;
+            }
+
+            if (best < 0)
+            {
+                // the remaining bits are in no open check
+                for (int j = k; j < mN; ++j)
+                {
+                    if (!known[j])
+                    {
+                        mGapCols.push_back(j);
+                        resolve(j);
+                        --unknown;
+                    }
+                }
+                break;
+            }
+
+            int remaining = degree[best];
+            for (auto j : mRows[best])
+            {
+                if (!known[j] && remaining-- > 1)
+                {
+                    mGapCols.push_back(j);
+                    resolve(j);
+                    --unknown;
+                }
+            }
+        }
+
+        for (int i = 0; i < m; ++i)
+        {
+            if (!rowDone[i])
+                mGapRows.push_back(i);
+        }
+
+        // phi maps the gap bits to the gap checks with the information bits zero
+        const int gc = mGapCols.size();
+        const int gr = mGapRows.size();
+        const int words = (gc + gr + 63) / 64;
+        vec_u64 phi(static_cast<u64>(gr) * words, 0);
+        vec_bits_t c(mN);
+        for (int b = 0; b < gc; ++b)
+        {
+            std::fill(c.begin(), c.end(), 0);
+            c[mGapCols[b]] = 1;
+            substitute(c);
+            for (int r = 0; r < gr; ++r)
+            {
+                if (check(c, mGapRows[r]).value)
+                    phi[r * words + b / 64] |= u64(1) << (b % 64);
+            }
+        }
+
+        // Gauss-Jordan elimination of [phi | I], the right half records the row operations
+        for (int r = 0; r < gr; ++r)
+        {
+            phi[r * words + (gc + r) / 64] |= u64(1) << ((gc + r) % 64);
+        }
+
+        auto bit = [&](const int r, const int b) { return (phi[r * words + b / 64] >> (b % 64)) & 1; };
+
+        vec_int pivotCol;
+        for (int col = 0; col < gc; ++col)
+        {
+            const int rank = pivotCol.size();
+            int pivot = rank;
+            while (pivot < gr && !bit(pivot, col))
+                ++pivot;
+            if (pivot == gr)
+                continue;
+
+            if (pivot != rank)
+                std::swap_ranges(phi.begin() + pivot * words, phi.begin() + (pivot + 1) * words, phi.begin() + rank * words);
+
+            for (int r = 0; r < gr; ++r)
+            {
+                if (r != rank && bit(r, col))
+                {
+                    for (int w = 0; w < words; ++w)
+                        phi[r * words + w] ^= phi[rank * words + w];
+                }
+            }
+            pivotCol.push_back(col);
+        }
+
+        // gap bits without pivot are free and set to zero, each
+        // remaining row is a dependency of the gap checks
+        const int rank = pivotCol.size();
+        for (int r = rank; r < gr; ++r)
+        {
+            vec_bits_t y(gr);
+            for (int i = 0; i < gr; ++i)
+                y[i] = bit(r, gc + i);
+
+            if (!is_dependent(H, y))
+                throw std::runtime_error("h_encoder(): parity part of H does not span H");
+        }
+
+        mWords = (gr + 63) / 64;
+        mPhiInv = vec_u64(static_cast<u64>(gc) * mWords, 0);
+        for (int i = 0; i < rank; ++i)
+        {
+            for (int r = 0; r < gr; ++r)
+            {
+                if (bit(i, gc + r))
+                    mPhiInv[pivotCol[i] * mWords + r / 64] |= u64(1) << (r % 64);
+            }
+        }
+    }
+
+    bool h_encoder::is_dependent(const sparse_csr<bits_t> &H, const vec_bits_t &y) const
+    {
+        // combination w of all checks with w = y on the gap checks, such that
+        // the columns of the parity part sum to zero, solved backwards over the
+        // triangular part: the rows of an earlier step do not hold its bit
+        vec_bits_t w(H.num_rows(), 0);
+        for (u64 r = 0; r < mGapRows.size(); ++r)
+            w[mGapRows[r]] = y[r];
+
+        for (auto t = mTriangular.rbegin(); t != mTriangular.rend(); ++t)
+        {
+            bits_t sum = 0;
+            for (const auto &n : H.col_neighbor()[t->second])
+            {
+                if (n.nodeIndex != t->first)
+                    sum += w[n.nodeIndex];
+            }
+            w[t->first] = sum;
+        }
+
+        // the checks are dependent if the combination vanishes on all bits
+        for (int j = 0; j < mN; ++j)
+        {
+            bits_t sum = 0;
+            for (const auto &n : H.col_neighbor()[j])
+                sum += w[n.nodeIndex];
+            if (sum != 0)
+                return false;
+        }
+        return true;
+    }
+
+    bits_t h_encoder::check(const vec_bits_t &c, const int row) const
+    {
+        bits_t s = 0;
+        for (auto j : mRows[row])
+        {
+            s += c[j];
+        }
+        return s;
+    }
+
+    void h_encoder::substitute(vec_bits_t &c) const
+    {
+        for (const auto &t : mTriangular)
+        {
+            c[t.second] = 0;
+            c[t.second] = check(c, t.first);
+        }
+    }
+
+    void h_encoder::encode(const vec_bits_t &u, vec_bits_t &c) const
+    {
+        const int k = this->k();
+        std::copy(u.begin(), u.begin() + k, c.begin());
+        std::fill(c.begin() + k, c.end(), 0);
+
+        substitute(c);
+
+        if (!mGapCols.empty())
+        {
+            // the syndrome of the gap checks determines the gap bits
+            vec_u64 s(mWords, 0);
+            for (u64 r = 0; r < mGapRows.size(); ++r)
+            {
+                s[r / 64] |= u64(check(c, mGapRows[r]).value) << (r % 64);
+            }
+
+            for (u64 b = 0; b < mGapCols.size(); ++b)
+            {
+                u64 acc = 0;
+                for (int w = 0; w < mWords; ++w)
+                {
+                    acc ^= s[w] & mPhiInv[b * mWords + w];
+                }
+                c[mGapCols[b]] = __builtin_parityl(acc);
+            }
+
+            substitute(c);
+        }
+    }
+
+    vec_bits_t h_encoder::encode(const vec_bits_t &u) const
+    {
+        vec_bits_t c(mN);
+        encode(u, c);
+        return c;
+    }
+
+    void h_encoder::save(binary_writer &out) const
+    {
+        vec_int rows, cols;
+        for (const auto &t : mTriangular)
+        {
+            rows.push_back(t.first);
+            cols.push_back(t.second);
+        }
+
+        out.put(mN);
+        out.put(mRows);
+        out.put(rows);
+        out.put(cols);
+        out.put(mGapCols);
+        out.put(mGapRows);
+        out.put(mWords);
+        out.put(mPhiInv);
+    }
+
+    void h_encoder::load(binary_reader &in)
+    {
+        vec_int rows, cols;
+
+        in.get(mN);
+        in.get(mRows);
+        in.get(rows);
+        in.get(cols);
+        in.get(mGapCols);
+        in.get(mGapRows);
+        in.get(mWords);
+        in.get(mPhiInv);
+
+        if (rows.size() != cols.size())
+            throw std::runtime_error("h_encoder: corrupt cache");
+
+        mTriangular.clear();
+        for (u64 i = 0; i < rows.size(); ++i)
+            mTriangular.push_back(std::make_pair(rows[i], cols[i]));
+    }
+} // namespace ldpc
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "functions.h"
+
+namespace ldpc
+{
+    /**
+     * @brief Dense encoder with the generator matrix packed into 64-bit words.
+     *
+     * If G is systematic, the information bits are copied and only the
+     * parity part is stored, one packed row over the information bits per
+     * parity position, so each parity bit is the popcount parity of an AND.
+     * Otherwise all positions are stored this way.
+     */
+    class packed_encoder
+    {
+    public:
+        packed_encoder() = default;
+
+        /**
+         * @brief Pack the generator matrix.
+         *
+         * @param G Generator matrix
+         * @param infoPos Codeword position of each information bit, empty if G is not systematic
+         */
+        packed_encoder(const sparse_csr<bits_t> &G, const vec_int &infoPos);
+
+        /**
+         * @brief Encode an information word.
+         *
+         * @param u Information word of length k
+         * @param c Codeword of length n, overwritten
+         */
+        void encode(const vec_bits_t &u, vec_bits_t &c) const;
+        vec_bits_t encode(const vec_bits_t &u) const;
+
+        /**
+         * @brief Bit-sliced encoding of 64 information words in one pass.
+         *
+         * @param u k words, bit b of u[i] is information bit i of word b
+         * @param c n words, bit b of c[j] is codeword bit j of word b
+         */
+        void encode_sliced(const vec_u64 &u, vec_u64 &c) const;
+
+        // Information word length
+        int k() const { return mK; }
+        // Codeword length
+        int n() const { return mN; }
+        // Whether the information bits are copied
+        bool systematic() const { return !mInfoPos.empty(); }
+
+        void save(binary_writer &out) const;
+        void load(binary_reader &in);
+
+    private:
+        int mK = 0;
+        int mN = 0;
+        int mWords = 0; // 64-bit words of a packed row
+
+        vec_int mInfoPos;
+
+        // positions computed from the packed rows and the rows themselves
+        vec_int mParityPos;
+        vec_u64 mParity;
+
+        // information bits of each parity position for bit-sliced encoding
+        mat_int mParityN;
+    };
+
+    /**
+     * @brief Encoder from the parity-check matrix H = [H_s | H_p], i.e. the
+     * information bits are the first n - m positions.
+     *
+     * The parity part is brought into approximate lower-triangular form
+     * (Richardson-Urbanke): checks with a single unknown parity bit are
+     * solved by back-substitution, and where none is left a few parity
+     * bits are declared gap bits. These are obtained from the remaining
+     * gap checks with the dense g x g matrix phi^-1, after which the
+     * back-substitution is repeated. Dual-diagonal (IRA) parity parts are
+     * triangular, so g = 0 and encoding is linear in the number of edges.
+     * Redundant checks are allowed, the gap bits they leave free are zero.
+     */
+    class h_encoder
+    {
+    public:
+        h_encoder() = default;
+
+        /**
+         * @brief Triangulate the parity part of H.
+         *
+         * @throw runtime_error if the parity part does not span H
+         * @param H Parity-check matrix
+         */
+        h_encoder(const sparse_csr<bits_t> &H);
+
+        /**
+         * @brief Encode an information word.
+         *
+         * @param u Information word of length k = n - m
+         * @param c Codeword of length n, overwritten
+         */
+        void encode(const vec_bits_t &u, vec_bits_t &c) const;
+        vec_bits_t encode(const vec_bits_t &u) const;
+
+        // Information word length
+        int k() const { return mN - static_cast<int>(mRows.size()); }
+        // Codeword length
+        int n() const { return mN; }
+        // Number of gap bits, 0 for triangular parity parts
+        int gap() const { return mGapCols.size(); }
+
+        void save(binary_writer &out) const;
+        void load(binary_reader &in);
+
+    private:
+        // back-substitution of the triangular part followed by the gap checks
+        void substitute(vec_bits_t &c) const;
+        bits_t check(const vec_bits_t &c, const int row) const;
+        // true if the combination y of the gap checks is a dependency of H
+        bool is_dependent(const sparse_csr<bits_t> &H, const vec_bits_t &y) const;
+
+        int mN = 0;
+
+        // column indices of each check
+        mat_int mRows;
+
+        // check and parity bit of each back-substitution step, in order
+        std::vector<std::pair<int, int>> mTriangular;
+
+        vec_int mGapCols;
+        vec_int mGapRows;
+
+        // (pseudo-)inverse of phi, a packed row of gap check bits per gap bit
+        int mWords = 0;
+        vec_u64 mPhiInv;
+    };
+} // namespace ldpc
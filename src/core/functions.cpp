@@ -20,7 +20,13 @@ namespace ldpc
     {
         os << " Type: " << p.type << "\n";
         os << " Iterations: " << p.iterations << "\n";
-        os << " Early Termination: " << p.earlyTerm;
+        os << " Early Termination: " << p.earlyTerm << "\n";
+        os << " Block Iterations: " << p.blockIterations << "\n";
+        os << " CRC Polynomial: 0x" << std::hex << p.crcPoly << std::dec << "\n";
+        os << " Weight File: " << (p.weightFile ? p.weightFile : "") << "\n";
+        os << " Table File: " << (p.tableFile ? p.tableFile : "") << "\n";
+        os << " Warm Start: " << p.warmStart << "\n";
+        os << " Min-Sum Offset: " << p.msOffset;
         return os;
     }
 
@@ -37,7 +43,8 @@ namespace ldpc
         os << " Threads: " << p.threads << "\n";
         os << " FEC: " << p.fec << "\n";
         os << " Max Frames: " << p.maxFrames << "\n";
-        os << " Output File: " << p.resultFile;
+        os << " Output File: " << p.resultFile << "\n";
+        os << " Transmissions: " << p.transmissions;
         return os;
     }
 } // namespace ldpc
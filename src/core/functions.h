@@ -12,6 +12,8 @@
 #include <unordered_map>
 #include <variant>
 #include <forward_list>
+#include <functional>
+#include <utility>
 
 #include "gf2.h"
 #include "sparse.h"
@@ -87,10 +89,8 @@ namespace ldpc
         return os;
     }
 
+    // u64, u32 and u8 are declared with the binary file format in binary_io.h
     using bits_t = gf2;
-    using u64 = unsigned long;
-    using u32 = unsigned int;
-    using u8 = unsigned char;
 
     using vec_bits_t = std::vector<bits_t>;
     using vec_u64 = std::vector<u64>;
@@ -104,11 +104,18 @@ namespace ldpc
 
     constexpr u8 ERASURE = 'E';
 
+    // defaults are flooding BP with syndrome early termination
     struct
     {
-        bool earlyTerm;
-        u32 iterations;
-        const char *type;
+        bool earlyTerm = true;
+        u32 iterations = 50;
+        const char *type = "BP";
+        u32 blockIterations = 0;     // local iterations per cache-sized layer, 0 for flooding
+        u64 crcPoly = 0;             // CRC polynomial over the information bits for early termination, 0 to disable
+        const char *weightFile = ""; // CN weight file for weighted min-sum ("BP_WMS")
+        const char *tableFile = "";  // table file for lookup-table decoding ("LUT")
+        bool warmStart = false;      // cascaded decoding: resume from the messages of the previous stage
+        double msOffset = 0.5;       // offset of offset min-sum ("BP_OMS")
     } typedef decoder_param;
 
     struct
@@ -124,6 +131,7 @@ namespace ldpc
         u64 maxFrames;
         u64 fec;
         const char *resultFile;
+        u32 transmissions; // IR-HARQ transmissions per frame, the punctured bits are sent in equal parts
     } typedef simulation_param;
 
     std::ostream &operator<<(std::ostream &os, const decoder_param &p);
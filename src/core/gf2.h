@@ -10,6 +10,9 @@ namespace ldpc
      */
     struct gf2
     {
+        // Field size
+        static constexpr int q = 2;
+
         gf2() = default;
         gf2(const int val)
             : value(val != 0) {}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <iostream>
+#include <array>
+#include <stdexcept>
+
+namespace ldpc
+{
+    /**
+     * @brief Implements Galois Field GF(2^M), M <= 8, with log/antilog tables.
+     *
+     * Elements are polynomials over GF(2) in binary representation, i.e.
+     * addition is the XOR of the values. The field is generated by a fixed
+     * primitive polynomial of degree M.
+     *
+     * @tparam M Extension degree
+     */
+    template <int M>
+    struct gf2m
+    {
+        static_assert(M >= 1 && M <= 8, "gf2m: extension degree must be 1 to 8");
+
+        // Field size q = 2^M
+        static constexpr int q = 1 << M;
+
+        gf2m() = default;
+        gf2m(const int val)
+            : value(static_cast<unsigned char>(val & (q - 1))) {}
+
+        gf2m &operator=(const int val)
+        {
+            value = static_cast<unsigned char>(val & (q - 1));
+            return *this;
+        }
+
+        gf2m &operator+=(const gf2m &a)
+        {
+            value ^= a.value;
+            return *this;
+        }
+
+        // Multiplicative inverse, undefined for zero
+        gf2m inverse() const
+        {
+            return gf2m(tables().exp[(q - 1 - tables().log[value]) % (q - 1)]);
+        }
+
+        friend gf2m operator-(const gf2m &a) { return a; }
+        friend gf2m operator+(const gf2m &a, const gf2m &b) { return gf2m(a.value ^ b.value); }
+
+        friend gf2m operator*(const gf2m &a, const gf2m &b)
+        {
+            if (a.value == 0 || b.value == 0)
+                return gf2m(0);
+            return gf2m(tables().exp[tables().log[a.value] + tables().log[b.value]]);
+        }
+
+        friend gf2m operator/(const gf2m &a, const gf2m &b)
+        {
+            if (b.value == 0)
+                throw std::runtime_error("gf2m: division by zero");
+            return a * b.inverse();
+        }
+
+        friend bool operator==(const gf2m &a, const gf2m &b) { return (a.value == b.value); }
+        friend bool operator!=(const gf2m &a, const gf2m &b) { return (a.value != b.value); }
+
+        friend std::ostream &operator<<(std::ostream &os, const gf2m &a)
+        {
+            os << static_cast<int>(a.value);
+            return os;
+        }
+
+        friend std::istream &operator>>(std::istream &is, gf2m &a)
+        {
+            int val = 0; // no value given
+            is >> val;
+            if (val < 0 || val >= q)
+                throw std::runtime_error("gf2m: value out of field range");
+            a.value = static_cast<unsigned char>(val);
+            return is;
+        }
+
+        // log/antilog tables, the antilog table is doubled to skip the modulo of a product
+        struct log_tables
+        {
+            std::array<unsigned char, q> log;
+            std::array<unsigned char, 2 * q> exp;
+        };
+
+        static const log_tables &tables()
+        {
+            static const log_tables t = make_tables();
+            return t;
+        }
+
+        unsigned char value;
+
+    private:
+        static log_tables make_tables()
+        {
+            // primitive polynomials of degree 1 to 8
+            constexpr int primitive[] = {0, 0x3, 0x7, 0xB, 0x13, 0x25, 0x43, 0x89, 0x11D};
+
+            log_tables t{};
+            int x = 1;
+            for (int i = 0; i < q - 1; ++i)
+            {
+                t.exp[i] = static_cast<unsigned char>(x);
+                t.exp[i + q - 1] = static_cast<unsigned char>(x);
+                t.log[x] = static_cast<unsigned char>(i);
+
+                x <<= 1;
+                if (x & q)
+                    x ^= primitive[M];
+            }
+            return t;
+        }
+    };
+} // namespace ldpc
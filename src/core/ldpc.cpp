@@ -1,17 +1,63 @@
 #include "ldpc.h"
+#include "bit_matrix.h"
 #include <iterator>
+#include <numeric>
+#include <future>
+#include <string_view>
 
 namespace ldpc
 {
 
     ldpc_code::ldpc_code(const std::string &pcFileName)
+        : ldpc_code(pcFileName, std::string())
+    {
+    }
+
+    ldpc_code::ldpc_code(const std::string &pcFileName, const std::string &genFileName, const std::string &cacheDir, const u64 layerCacheBytes)
         : mMaxDegree(0),
           mH(),
-          mG()
+          mG(),
+          mNNZGraph(0),
+          mLayerCacheBytes(layerCacheBytes)
     {
         try
         {
+            // the cache is named after the codefile, its hash tells codes of the same name apart
+            const bool useCache = !cacheDir.empty();
+            u64 hash = 0;
+            const auto name = pcFileName.substr(pcFileName.find_last_of('/') + 1);
+            const auto cacheFile = cacheDir + "/" + name + ".cache";
+            if (useCache)
+            {
+                hash = source_hash(pcFileName, genFileName);
+                if (load_cache(cacheFile, hash))
+                {
+                    return;
+                }
+            }
+
+            // H and G are independent, G is read concurrently
+            std::future<void> gen;
+            if (!genFileName.empty())
+            {
+                gen = std::async(std::launch::async, [this, &genFileName]() { read_G(genFileName); });
+            }
             read_H(pcFileName);
+            if (gen.valid())
+            {
+                gen.get();
+            }
+
+            if (mG.empty())
+            {
+                init_h_encoder();
+            }
+
+            // a failed write only costs the next start
+            if (useCache)
+            {
+                save_cache(cacheFile, hash);
+            }
         }
         catch (std::exception &e)
         {
@@ -20,89 +66,658 @@ namespace ldpc
         }
     }
 
-    ldpc_code::ldpc_code(const std::string &pcFileName, const std::string &genFileName)
-        : ldpc_code(pcFileName)
+    ldpc_code::ldpc_code(const sparse_csr<bits_t> &H, const vec_int &puncture, const vec_int &shorten)
+        : mPuncture(puncture),
+          mShorten(shorten),
+          mH(H)
+    {
+        check_bit_indices();
+        compile();
+        init_h_encoder();
+    }
+
+    void ldpc_code::check_bit_indices() const
+    {
+        for (auto i : mPuncture)
+        {
+            if (i < 0 || i >= nc())
+                throw std::runtime_error("ldpc_code(): puncture index out of range");
+        }
+        for (auto i : mShorten)
+        {
+            if (i < 0 || i >= nc())
+                throw std::runtime_error("ldpc_code(): shorten index out of range");
+        }
+    }
+
+    ldpc_code::ldpc_code(const qc_matrix &qc, const vec_int &puncture, const vec_int &shorten)
+        : ldpc_code(qc.expand(), puncture, shorten)
+    {
+        mQC = qc;
+    }
+
+    void ldpc_code::init_h_encoder()
+    {
+        // without G, encode from H if its parity part is invertible
+        try
+        {
+            mHEncoder = h_encoder(mH);
+            mInfoPos = vec_int(kc());
+            std::iota(mInfoPos.begin(), mInfoPos.end(), 0);
+            return;
+        }
+        catch (std::exception &e)
+        {
+            mHEncoder = h_encoder();
+        }
+
+        // otherwise derive G, systematic in the free columns of the row reduced H
+        try
+        {
+            vec_int perm;
+            mG = generator_matrix(mH, perm, kc()).to_sparse();
+            mInfoPos.assign(perm.begin(), perm.begin() + kc());
+            mEncoder = packed_encoder(mG, mInfoPos);
+        }
+        catch (std::exception &e)
+        {
+            mG = sparse_csr<bits_t>();
+            mEncoder = packed_encoder();
+            mInfoPos.clear();
+        }
+    }
+
+    u64 ldpc_code::source_hash(const std::string &pcFileName, const std::string &genFileName)
     {
+        u64 hash = content_hash(reinterpret_cast<const char *>(&CODE_CACHE_VERSION), sizeof(CODE_CACHE_VERSION));
+
+        mapped_file pc(pcFileName);
+        hash = content_hash(pc.data(), pc.size(), hash);
         if (!genFileName.empty())
         {
-            try
-            {
-                read_G(genFileName);
-            }
-            catch (std::exception &e)
+            // the separator tells H without G from G appended to H
+            hash = content_hash("G", 1, hash);
+            mapped_file gen(genFileName);
+            hash = content_hash(gen.data(), gen.size(), hash);
+        }
+        return hash;
+    }
+
+    bool ldpc_code::load_cache(const std::string &cacheFile, const u64 hash)
+    {
+        try
+        {
+            mapped_file file(cacheFile);
+            binary_reader in(file.data(), file.size());
+
+            u64 magic, fileHash, layerCacheBytes;
+            u32 version;
+            in.get(magic);
+            in.get(version);
+            in.get(fileHash);
+            in.get(layerCacheBytes);
+            // the layers are only valid for the budget they were built with
+            if (magic != CODE_CACHE_MAGIC || version != CODE_CACHE_VERSION || fileHash != hash || layerCacheBytes != mLayerCacheBytes)
             {
-                std::cout << "Error: ldpc_code(): " << e.what() << std::endl;
-                exit(EXIT_FAILURE);
+                return false;
             }
+
+            in.get(mPuncture);
+            in.get(mShorten);
+            in.get(mMaxDegree);
+            in.get(mBitPos);
+            // a QC code stores only its base matrix, H is expanded again
+            mQC.load(in);
+            if (mQC.empty())
+                mH.load(in);
+            else
+                mH = mQC.expand();
+            mG.load(in);
+            in.get(mInfoPos);
+            mEncoder.load(in);
+            mHEncoder.load(in);
+            in.get(mCheckN);
+            in.get(mVarN);
+            in.get(mPrunedEdges);
+            in.get(mNNZGraph);
+            in.get(mLayers);
+            mark_bits();
+            return true;
+        }
+        catch (std::exception &e)
+        {
+            // missing or broken cache, rebuild
+            const auto layerCacheBytes = mLayerCacheBytes;
+            *this = ldpc_code();
+            mLayerCacheBytes = layerCacheBytes;
+            return false;
         }
     }
 
+    bool ldpc_code::save_cache(const std::string &cacheFile, const u64 hash) const
+    {
+        binary_writer out;
+        out.put(CODE_CACHE_MAGIC);
+        out.put(CODE_CACHE_VERSION);
+        out.put(hash);
+        out.put(mLayerCacheBytes);
+
+        out.put(mPuncture);
+        out.put(mShorten);
+        out.put(mMaxDegree);
+        out.put(mBitPos);
+        mQC.save(out);
+        if (mQC.empty())
+            mH.save(out);
+        mG.save(out);
+        out.put(mInfoPos);
+        mEncoder.save(out);
+        mHEncoder.save(out);
+        out.put(mCheckN);
+        out.put(mVarN);
+        out.put(mPrunedEdges);
+        out.put(mNNZGraph);
+        out.put(mLayers);
+
+        return out.write_to_file(cacheFile);
+    }
+
     void ldpc_code::read_H(const std::string &pcFileName)
     {
-        std::ifstream infile(pcFileName);
-        std::string line;
-        int skipLines = 0;
+        parse_H(pcFileName, mH, mQC, mPuncture, mShorten);
 
-        if (!infile.good())
-            throw std::runtime_error("can not open file for reading");
+        // the indices of a file are only trusted once they are in range
+        check_bit_indices();
+        compile();
+    }
 
-        while (getline(infile, line))
-        {
-            // support legacy code files
-            // where code parameters are separated by ':'
-            if (auto i = line.find(':'); i != std::string::npos)
-            {
-                int index;
-                auto token = line.substr(0, i);
-                std::istringstream record(line.substr(i + 1));
+    void ldpc_code::parse_H(const std::string &pcFileName, sparse_csr<bits_t> &H, qc_matrix &qc, vec_int &puncture, vec_int &shorten)
+    {
+        H = sparse_csr<bits_t>();
+        qc = qc_matrix();
+        puncture.clear();
+        shorten.clear();
 
-                if (token.find("puncture") != std::string::npos)
-                {
-                    while (record >> index)
-                        mPuncture.push_back(index);
-                }
-                else if (token.find("shorten") != std::string::npos)
+        mapped_file file(pcFileName);
+        const char *first = file.data();
+        const char *last = first + file.size();
+
+        auto read_indices = [](const char *p, const char *end, vec_int &indices) {
+            while (p != end)
+            {
+                if (*p == ' ' || *p == '\t' || *p == '\r')
                 {
-                    while (record >> index)
-                        mShorten.push_back(index);
+                    ++p;
+                    continue;
                 }
 
-                ++skipLines;
+                int index;
+                auto [ptr, ec] = std::from_chars(p, end, index);
+                if (ec != std::errc())
+                    break;
+                indices.push_back(index);
+                p = ptr;
             }
-            else
+        };
+
+        while (first != last)
+        {
+            const char *eol = std::find(first, last, '\n');
+
+            // support legacy code files
+            // where code parameters are separated by ':'
+            const char *colon = std::find(first, eol, ':');
+            if (colon == eol)
             {
                 break;
             }
+
+            std::string_view token(first, colon - first);
+            if (token.find("puncture") != std::string_view::npos)
+            {
+                read_indices(colon + 1, eol, puncture);
+            }
+            else if (token.find("shorten") != std::string_view::npos)
+            {
+                read_indices(colon + 1, eol, shorten);
+            }
+
+            first = (eol == last) ? last : eol + 1;
+        }
+
+        // the format follows from the file extension, CSR triplets otherwise
+        auto has_extension = [&pcFileName](const std::string &ext) {
+            return pcFileName.size() >= ext.size() && pcFileName.compare(pcFileName.size() - ext.size(), ext.size(), ext) == 0;
+        };
+
+        if (has_extension(".alist"))
+        {
+            H.parse_alist(first, last);
+        }
+        else if (has_extension(".qc"))
+        {
+            qc.parse(first, last);
+            H = qc.expand();
+        }
+        else
+        {
+            H.parse(first, last);
+        }
+    }
+
+    void ldpc_code::compile()
+    {
+        update_max_degree();
+
+        // position of transmitted bits, i.e. neither shortened nor punctured
+        mBitPos.clear();
+        std::vector<bool> transmitted(nc(), true);
+        for (auto i : mShorten)
+        {
+            if (i >= 0 && i < nc())
+                transmitted[i] = false;
+        }
+        for (auto i : mPuncture)
+        {
+            if (i >= 0 && i < nc())
+                transmitted[i] = false;
+        }
+        for (int i = 0; i < nc(); i++)
+        {
+            if (transmitted[i])
+                mBitPos.push_back(i);
+        }
+
+        reduce_graph();
+    }
+
+    void ldpc_code::read_G(const std::string &genFileName)
+    {
+        mG.read_from_file(genFileName, 0);
+
+        // a weight-1 column of G copies the information bit of its row
+        mInfoPos = vec_int(mG.num_rows(), -1);
+        for (int j = 0; j < mG.num_cols(); ++j)
+        {
+            const auto &col = mG.col_neighbor()[j];
+            if (col.size() == 1 && mInfoPos[col[0].nodeIndex] < 0)
+            {
+                mInfoPos[col[0].nodeIndex] = j;
+            }
         }
 
-        infile.close();
+        if (std::find(mInfoPos.begin(), mInfoPos.end(), -1) != mInfoPos.end())
+        {
+            mInfoPos.clear();
+        }
 
-        mH.read_from_file(pcFileName, skipLines);
+        mEncoder = packed_encoder(mG, mInfoPos);
+    }
 
+    void ldpc_code::update_max_degree()
+    {
         // maximum node degree
         auto cd = std::max_element(mH.row_neighbor().begin(), mH.row_neighbor().end(),
                                     [](const auto &a, const auto &b) { return (a.size() < b.size()); });
         auto vd = std::max_element(mH.col_neighbor().begin(), mH.col_neighbor().end(),
                                     [](const auto &a, const auto &b) { return (a.size() < b.size()); });
-        mMaxDegree = std::max(cd->size(), vd->size());
+        mMaxDegree = std::max((cd == mH.row_neighbor().end()) ? 0 : cd->size(), (vd == mH.col_neighbor().end()) ? 0 : vd->size());
+    }
 
-        // position of transmitted bits
-        for (int i = 0; i < nc(); i++)
+    void ldpc_code::mark_bits()
+    {
+        mIsShortened.assign(nc(), false);
+        mIsPunctured.assign(nc(), false);
+        for (auto s : mShorten)
+            mIsShortened[s] = true;
+        for (auto p : mPuncture)
+            mIsPunctured[p] = true;
+    }
+
+    std::vector<node> ldpc_code::reduce_check(const int i, int &prunedEdge) const
+    {
+        const auto &cn = mH.row_neighbor()[i];
+
+        int numPrunable = 0;
+        prunedEdge = -1;
+        std::vector<node> reduced;
+        for (const auto &r : cn)
+        {
+            if (mIsPunctured[r.nodeIndex] && mH.col_neighbor()[r.nodeIndex].size() == 1)
+            {
+                ++numPrunable;
+                prunedEdge = r.edgeIndex;
+            }
+            if (!mIsShortened[r.nodeIndex])
+            {
+                reduced.push_back(r);
+            }
+        }
+
+        // the check can only send zero messages to its other bits,
+        // the punctured bit is recovered from it after decoding
+        if (numPrunable == 1)
+            return std::vector<node>();
+        prunedEdge = -1;
+
+        // a single remaining bit is forced to zero by the shortened bits,
+        // keep the full check so the decoder propagates this
+        if (reduced.size() == 1)
+            return cn;
+
+        // empty if only shortened bits, the check is always satisfied
+        return reduced;
+    }
+
+    void ldpc_code::reduce_graph()
+    {
+        mark_bits();
+
+        mCheckN = std::vector<std::vector<node>>(mc(), std::vector<node>());
+        mVarN = std::vector<std::vector<node>>(nc(), std::vector<node>());
+        mPrunedEdges.clear();
+        mNNZGraph = 0;
+
+        for (int i = 0; i < mc(); ++i)
         {
-            auto tmp = std::find(mShorten.cbegin(), mShorten.cend(), i);
-            if (tmp != mShorten.cend())
-                continue; // skip if current index shortened
-            tmp = std::find(mPuncture.cbegin(), mPuncture.cend(), i);
-            if (tmp != mPuncture.cend())
-                continue; // skip if current index punctured
+            int prunedEdge;
+            mCheckN[i] = reduce_check(i, prunedEdge);
+            if (prunedEdge >= 0)
+                mPrunedEdges.push_back(prunedEdge);
+        }
 
-            mBitPos.push_back(i);
+        for (int i = 0; i < mc(); ++i)
+        {
+            for (const auto &r : mCheckN[i])
+            {
+                mVarN[r.nodeIndex].push_back(node({i, r.edgeIndex}));
+                ++mNNZGraph;
+            }
         }
+
+        partition_layers(mLayerCacheBytes);
     }
 
-    void ldpc_code::read_G(const std::string &genFileName)
+    void ldpc_code::partition_layers(const u64 cacheBytes)
     {
-        mG.read_from_file(genFileName, 0);
+        // per edge: both messages and the neighbour index
+        constexpr u64 edgeBytes = 2 * sizeof(double) + sizeof(node);
+        // per variable: channel and APP LLR
+        constexpr u64 varBytes = 2 * sizeof(double);
+
+        vec_int lastLayer(nc(), -1);
+        int layer = -1;
+        u64 layerBytes = 0;
+
+        mLayerCacheBytes = cacheBytes;
+        mLayers.clear();
+        for (int i = 0; i < mc(); ++i)
+        {
+            const auto &cn = mCheckN[i];
+            if (cn.empty())
+                continue;
+
+            u64 checkBytes = cn.size() * edgeBytes;
+            for (const auto &r : cn)
+            {
+                if (lastLayer[r.nodeIndex] != layer)
+                    checkBytes += varBytes;
+            }
+
+            // start a new layer if the check does not fit anymore
+            if (layer < 0 || layerBytes + checkBytes > cacheBytes)
+            {
+                mLayers.push_back(vec_int());
+                ++layer;
+                layerBytes = cn.size() * (edgeBytes + varBytes);
+            }
+            else
+            {
+                layerBytes += checkBytes;
+            }
+
+            for (const auto &r : cn)
+                lastLayer[r.nodeIndex] = layer;
+
+            mLayers.back().push_back(i);
+        }
+    }
+
+    vec_int ldpc_code::affected_checks(const int row, const int col) const
+    {
+        // the degree of a punctured bit decides whether its check is pruned
+        vec_int checks(1, row);
+        if (mIsPunctured[col])
+        {
+            for (const auto &c : mH.col_neighbor()[col])
+                checks.push_back(c.nodeIndex);
+        }
+        std::sort(checks.begin(), checks.end());
+        checks.erase(std::unique(checks.begin(), checks.end()), checks.end());
+        return checks;
+    }
+
+    void ldpc_code::drop_checks(const vec_int &checks)
+    {
+        const auto &edges = mH.nz_entry();
+        for (auto i : checks)
+        {
+            for (const auto &r : mCheckN[i])
+            {
+                auto &vn = mVarN[r.nodeIndex];
+                vn.erase(std::find_if(vn.begin(), vn.end(), [i](const node &x) { return x.nodeIndex == i; }));
+            }
+            mNNZGraph -= mCheckN[i].size();
+            mCheckN[i].clear();
+
+            mPrunedEdges.erase(std::remove_if(mPrunedEdges.begin(), mPrunedEdges.end(), [&edges, i](const int e) { return edges[e].rowIndex == i; }), mPrunedEdges.end());
+        }
+    }
+
+    void ldpc_code::build_checks(const vec_int &checks)
+    {
+        for (auto i : checks)
+        {
+            int prunedEdge;
+            mCheckN[i] = reduce_check(i, prunedEdge);
+            if (prunedEdge >= 0)
+                mPrunedEdges.push_back(prunedEdge);
+
+            // checks of a variable stay in ascending order
+            for (const auto &r : mCheckN[i])
+            {
+                auto &vn = mVarN[r.nodeIndex];
+                auto pos = std::lower_bound(vn.begin(), vn.end(), i, [](const node &x, const int c) { return x.nodeIndex < c; });
+                vn.insert(pos, node({i, r.edgeIndex}));
+            }
+            mNNZGraph += mCheckN[i].size();
+
+            place_in_layer(i);
+        }
+    }
+
+    void ldpc_code::move_edge_index(const int from, const int to)
+    {
+        const auto &e = mH.nz_entry()[to];
+        for (auto &r : mCheckN[e.rowIndex])
+        {
+            if (r.edgeIndex == from)
+                r.edgeIndex = to;
+        }
+        for (auto &c : mVarN[e.colIndex])
+        {
+            if (c.edgeIndex == from)
+                c.edgeIndex = to;
+        }
+        std::replace(mPrunedEdges.begin(), mPrunedEdges.end(), from, to);
+    }
+
+    void ldpc_code::place_in_layer(const int i)
+    {
+        const bool inGraph = !mCheckN[i].empty();
+        if (mLayers.empty())
+        {
+            if (inGraph)
+                mLayers.push_back(vec_int(1, i));
+            return;
+        }
+
+        // layers hold ascending checks, i belongs to the last one starting before it;
+        // the cache budget is only met again by partition_layers()
+        auto layer = std::upper_bound(mLayers.begin(), mLayers.end(), i, [](const int c, const vec_int &l) { return c < l.front(); });
+        if (layer != mLayers.begin())
+            --layer;
+
+        auto pos = std::lower_bound(layer->begin(), layer->end(), i);
+        const bool present = (pos != layer->end() && *pos == i);
+        if (inGraph && !present)
+        {
+            layer->insert(pos, i);
+        }
+        else if (!inGraph && present)
+        {
+            layer->erase(pos);
+            if (layer->empty())
+                mLayers.erase(layer);
+        }
+    }
+
+    void ldpc_code::edited()
+    {
+        // G and the encoder were derived from the unedited H
+        if (!mG.empty() || mHEncoder.n() > 0)
+        {
+            mG = sparse_csr<bits_t>();
+            mEncoder = packed_encoder();
+            mHEncoder = h_encoder();
+            mInfoPos.clear();
+        }
+        ++mRevision;
+    }
+
+    void ldpc_code::add_edge(const int row, const int col)
+    {
+        if (row < 0 || row >= mc() || col < 0 || col >= nc())
+            throw std::runtime_error("ldpc_code: edge index out of range");
+        if (mH.find_entry(row, col) >= 0)
+            throw std::runtime_error("ldpc_code: edge already exists");
+
+        auto checks = affected_checks(row, col);
+        drop_checks(checks);
+        mH.add_entry(row, col, bits_t(1));
+        build_checks(checks);
+
+        mMaxDegree = std::max<int>({mMaxDegree, static_cast<int>(mH.row_neighbor()[row].size()), static_cast<int>(mH.col_neighbor()[col].size())});
+        mQC = qc_matrix();
+        edited();
+    }
+
+    void ldpc_code::remove_edge(const int row, const int col)
+    {
+        if (mH.find_entry(row, col) < 0)
+            throw std::runtime_error("ldpc_code: edge does not exist");
+
+        auto checks = affected_checks(row, col);
+        drop_checks(checks);
+        const int last = nnz() - 1;
+        const int e = mH.remove_entry(row, col);
+        if (e != last)
+            move_edge_index(last, e);
+        build_checks(checks);
+
+        // only a node of maximum degree lowers it
+        if (static_cast<int>(mH.row_neighbor()[row].size()) + 1 == mMaxDegree || static_cast<int>(mH.col_neighbor()[col].size()) + 1 == mMaxDegree)
+            update_max_degree();
+        mQC = qc_matrix();
+        edited();
+    }
+
+    void ldpc_code::move_edge(const int row, const int col, const int newRow, const int newCol)
+    {
+        if (row == newRow && col == newCol)
+            return;
+        if (newRow < 0 || newRow >= mc() || newCol < 0 || newCol >= nc())
+            throw std::runtime_error("ldpc_code: edge index out of range");
+        if (mH.find_entry(newRow, newCol) >= 0)
+            throw std::runtime_error("ldpc_code: edge already exists");
+
+        remove_edge(row, col);
+        add_edge(newRow, newCol);
+    }
+
+    void ldpc_code::set_shift(const int i, const int j, const int shift)
+    {
+        if (!is_qc())
+            throw std::runtime_error("ldpc_code: set_shift requires a QC code");
+
+        const int Z = mQC.lift();
+        if (i < 0 || i >= mQC.base_rows() || j < 0 || j >= mQC.base_cols() || shift < -1 || shift >= Z)
+            throw std::runtime_error("ldpc_code: block index or shift out of range");
+
+        auto exponents = mQC.exponents();
+        const int old = exponents[i][j];
+        if (old == shift)
+            return;
+
+        // row r of the block holds column (r + s) mod Z
+        for (int r = 0; old >= 0 && r < Z; ++r)
+            remove_edge(i * Z + r, j * Z + (r + old) % Z);
+        for (int r = 0; shift >= 0 && r < Z; ++r)
+            add_edge(i * Z + r, j * Z + (r + shift) % Z);
+
+        exponents[i][j] = shift;
+        mQC = qc_matrix(exponents, Z);
+    }
+
+    vec_int ldpc_code::info_tx() const
+    {
+        // without systematic positions no information bit is shortened
+        if (mInfoPos.empty())
+        {
+            vec_int tx(kc());
+            std::iota(tx.begin(), tx.end(), 0);
+            return tx;
+        }
+
+        vec_int tx;
+        tx.reserve(mInfoPos.size());
+        for (int i = 0; i < static_cast<int>(mInfoPos.size()); ++i)
+        {
+            if (!mIsShortened[mInfoPos[i]])
+                tx.push_back(i);
+        }
+        return tx;
+    }
+
+    void ldpc_code::encode(const vec_bits_t &u, vec_bits_t &c) const
+    {
+        const vec_bits_t *info = &u;
+
+        // shortened information bits are known zeros, e.g. filler bits
+        vec_bits_t v;
+        if (!mShorten.empty() && !mInfoPos.empty())
+        {
+            std::vector<bool> isShortened(nc(), false);
+            for (auto s : mShorten)
+                isShortened[s] = true;
+
+            v = u;
+            for (std::size_t i = 0; i < mInfoPos.size() && i < v.size(); ++i)
+            {
+                if (isShortened[mInfoPos[i]])
+                    v[i] = 0;
+            }
+            info = &v;
+        }
+
+        if (!mG.empty())
+        {
+            mEncoder.encode(*info, c);
+        }
+        else
+        {
+            mHEncoder.encode(*info, c);
+        }
     }
 
     /**
@@ -118,6 +733,16 @@ namespace ldpc
         os << "M : " << code.mc() << "\n";
         os << "K : " << code.kc() << "\n";
         os << "NNZ : " << code.nnz() << "\n";
+        os << "NNZ (decoding graph) : " << code.nnz_graph() << "\n";
+        if (code.is_qc())
+            os << "QC base matrix : " << code.qc().base_rows() << " x " << code.qc().base_cols() << ", Z = " << code.qc().lift() << "\n";
+        os << "Layers : " << code.layers().size() << "\n";
+        if (!code.G().empty())
+            os << "Encoder : G\n";
+        else if (code.has_encoder())
+            os << "Encoder : H (gap " << code.encoder_h().gap() << ")\n";
+        else
+            os << "Encoder : none\n";
         //os << "Rank: " << code.mRank << "\n";
         //os << "max dc : " << code.max_degree() << "\n";
         os << "puncture[" << code.puncture().size() << "] : " << code.puncture() << "\n";
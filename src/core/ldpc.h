@@ -1,9 +1,17 @@
 #pragma once
 
 #include "functions.h"
+#include "encoder.h"
+#include "qc_matrix.h"
 
 namespace ldpc
 {
+    // default cache budget of a layer, i.e. a typical L2 size
+    constexpr u64 LAYER_CACHE_BYTES = 256 * 1024;
+
+    // binary code cache "LDPCBIN\0", the version changes with its layout
+    constexpr u64 CODE_CACHE_MAGIC = 0x004e494243504c44UL;
+    constexpr u32 CODE_CACHE_VERSION = 4;
 
     /**
     * @brief LDPC code class
@@ -22,18 +30,62 @@ namespace ldpc
         /**
          * @brief Construct a new ldpc code object
          * 
+         * If a cache directory is given, the compiled code, i.e. all arrays
+         * derived from the files, is cached there in the binary file
+         * <name of pcFileName>.cache, keyed by a hash of the file contents,
+         * and loaded from there on the next start.
+         * 
          * @param pcFileName parity-check matrix file
          * @param genFileName generator matrix file
+         * @param cacheDir Directory of the binary cache, empty for no cache
+         * @param layerCacheBytes Cache budget per layer in bytes, see partition_layers()
+         */
+        ldpc_code(const std::string &pcFileName, const std::string &genFileName, const std::string &cacheDir = std::string(), const u64 layerCacheBytes = LAYER_CACHE_BYTES);
+
+        /**
+         * @brief Construct a code from H in memory, without any file I/O.
+         * 
+         * @throw runtime_error if an index is out of range
+         * @param H Parity-check matrix
+         * @param puncture Punctured bit indices
+         * @param shorten Shortened bit indices
+         */
+        ldpc_code(const sparse_csr<bits_t> &H, const vec_int &puncture = vec_int(), const vec_int &shorten = vec_int());
+
+        /**
+         * @brief Construct a QC code in memory, without any file I/O.
+         * 
+         * @throw runtime_error if an index is out of range
+         * @param qc Base matrix and lifting size
+         * @param puncture Punctured bit indices
+         * @param shorten Shortened bit indices
          */
-        ldpc_code(const std::string &pcFileName, const std::string &genFileName);
+        ldpc_code(const qc_matrix &qc, const vec_int &puncture = vec_int(), const vec_int &shorten = vec_int());
 
         /**
          * @brief Read the parity-check matrix from file.
          * 
+         * Files ending in ".alist" are read in alist format, files ending
+         * in ".qc" as QC base matrix (see qc_matrix), all others as CSR
+         * triplets. All may start with puncture/shorten lines.
+         * 
          * @param pcFileName Filename
          */
         void read_H(const std::string &pcFileName);
 
+        /**
+         * @brief Parse a parity-check matrix file as read_H(), without
+         * checking the indices or building a code, e.g. for validation.
+         * 
+         * @throw runtime_error if the file can not be parsed
+         * @param pcFileName Filename
+         * @param H Parity-check matrix, expanded for a QC file
+         * @param qc Base matrix of a QC file, empty otherwise
+         * @param puncture Punctured bit indices
+         * @param shorten Shortened bit indices
+         */
+        static void parse_H(const std::string &pcFileName, sparse_csr<bits_t> &H, qc_matrix &qc, vec_int &puncture, vec_int &shorten);
+
         /**
          * @brief Read the generator matrix from file.
          * 
@@ -41,6 +93,89 @@ namespace ldpc
          */
         void read_G(const std::string &genFileName);
 
+        /**
+         * @brief Build the reduced decoding graph from H.
+         * 
+         * Shortened bits are known to be zero, hence their edges carry no
+         * information and are removed from all checks. A check containing
+         * exactly one punctured degree-1 bit only ever sends zero messages,
+         * so it is removed together with that bit; the bit is recovered
+         * from the check after decoding.
+         */
+        void reduce_graph();
+
+        /**
+         * @brief Partition the checks of the decoding graph into consecutive
+         * layers whose messages and variables fit into the cache budget.
+         * The code is partitioned on construction, the budget is kept for it.
+         * 
+         * @param cacheBytes Cache budget per layer in bytes
+         */
+        void partition_layers(const u64 cacheBytes);
+
+        /**
+         * @brief Encode an information word with G if given, otherwise
+         * from H, or with G derived from H if the parity part of H is
+         * singular. Shortened information bits are encoded as zeros.
+         * 
+         * @param u Information word of length kc()
+         * @param c Codeword of length nc(), overwritten
+         */
+        void encode(const vec_bits_t &u, vec_bits_t &c) const;
+
+        /**
+         * @brief Add the edge (row, col) to H.
+         * 
+         * The decoding graph, the layers and the maximum degree are updated
+         * incrementally, i.e. only the check row and, for a punctured bit,
+         * the checks of col are rebuilt. Existing edge indices are kept. G
+         * and the encoder no longer match H and are dropped, see
+         * update_encoder(), and the code is no longer taken as QC. Decoders
+         * of the code follow the edit before their next frame.
+         * 
+         * @throw runtime_error if the edge exists or is out of range
+         * @param row Check node
+         * @param col Variable node
+         */
+        void add_edge(const int row, const int col);
+
+        /**
+         * @brief Remove the edge (row, col) from H, updated as add_edge().
+         * The last edge takes over the edge index of the removed one.
+         * 
+         * @throw runtime_error if the edge does not exist
+         * @param row Check node
+         * @param col Variable node
+         */
+        void remove_edge(const int row, const int col);
+
+        /**
+         * @brief Move the edge (row, col) to (newRow, newCol).
+         * 
+         * @throw runtime_error if the edge does not exist or the new one does
+         * @param row Check node
+         * @param col Variable node
+         * @param newRow New check node
+         * @param newCol New variable node
+         */
+        void move_edge(const int row, const int col, const int newRow, const int newCol);
+
+        /**
+         * @brief Set the exponent of a block of a QC code and replace the Z
+         * edges of the block in H, updated as add_edge(). The code stays QC.
+         * 
+         * @throw runtime_error if the code is not QC or an index is out of range
+         * @param i Base row
+         * @param j Base column
+         * @param shift New exponent, -1 for the all-zero block
+         */
+        void set_shift(const int i, const int j, const int shift);
+
+        /**
+         * @brief Derive the encoder from the edited H, dropped by the edits.
+         */
+        void update_encoder() { init_h_encoder(); }
+
         friend std::ostream &operator<<(std::ostream &os, const ldpc_code &code);
 
         // Number of columns (variable nodes)
@@ -69,17 +204,95 @@ namespace ldpc
         const sparse_csr<bits_t> &H() const { return mH; }
         // Generator matrix
         const sparse_csr<bits_t> &G() const { return mG; }
-        
+        // Base matrix of a QC code, empty otherwise
+        const qc_matrix &qc() const { return mQC; }
+        // True if H was read as QC base matrix
+        bool is_qc() const { return !mQC.empty(); }
+        // Bit-packed encoder of G
+        const packed_encoder &encoder() const { return mEncoder; }
+        // Encoder from H, used if no G is given and the parity part of H is invertible
+        const h_encoder &encoder_h() const { return mHEncoder; }
+        // True if G is given or derived from H, or the parity part of H is invertible
+        bool has_encoder() const { return !mG.empty() || mHEncoder.n() > 0; }
+        // Variable node neighbours of checks in the decoding graph
+        const std::vector<std::vector<node>> &check_neighbor() const { return mCheckN; }
+        // Check node neighbours of variables in the decoding graph
+        const std::vector<std::vector<node>> &var_neighbor() const { return mVarN; }
+        // Edges of punctured degree-1 bits removed from the decoding graph
+        const vec_int &pruned_edges() const { return mPrunedEdges; }
+        // Positions of the systematic information bits, empty if not systematic
+        const vec_int &info_pos() const { return mInfoPos; }
+        // Indices of the transmitted, i.e. not shortened, bits of the information word
+        vec_int info_tx() const;
+        // Number of edges in the decoding graph
+        int nnz_graph() const { return mNNZGraph; }
+        // Check indices of the cache-sized layers of the decoding graph
+        const mat_int &layers() const { return mLayers; }
+        // Number of edits of H, decoders compare it to follow the edits
+        u64 revision() const { return mRevision; }
+
     private:
+        ldpc_code() = default;
+
+        // degrees, transmitted bits and decoding graph of H
+        void compile();
+        void check_bit_indices() const;
+        void init_h_encoder();
+
+        // shortened and punctured bits as masks for the decoding graph
+        void mark_bits();
+
+        // reduced neighbours of check i and its pruned edge, -1 if none
+        std::vector<node> reduce_check(const int i, int &prunedEdge) const;
+
+        // incremental updates of the derived arrays around an edit of H
+        vec_int affected_checks(const int row, const int col) const;
+        void drop_checks(const vec_int &checks);
+        void build_checks(const vec_int &checks);
+        void move_edge_index(const int from, const int to);
+        void place_in_layer(const int i);
+        void update_max_degree();
+        void edited();
+
+        // content hash of the code files and the cache version
+        static u64 source_hash(const std::string &pcFileName, const std::string &genFileName);
+        bool load_cache(const std::string &cacheFile, const u64 hash);
+        bool save_cache(const std::string &cacheFile, const u64 hash) const;
+
         vec_int mPuncture; /* array pf punctured bit indices */
         vec_int mShorten;  /* array of shortened bit indices */
-        int mMaxDegree;
+        int mMaxDegree = 0;
 
         // position of transmitted bits, i.e. puncture/shorten exluded
         vec_int mBitPos;
 
         sparse_csr<bits_t> mH; // Parity-Check Matrix
         sparse_csr<bits_t> mG; // Generator Matrix
+
+        // compact form of a QC code, H is its expansion, which the encoders
+        // and the decoding graph use
+        qc_matrix mQC;
+
+        // codeword position of each information bit, if G is systematic
+        vec_int mInfoPos;
+
+        packed_encoder mEncoder;
+        h_encoder mHEncoder;
+
+        // decoding graph, i.e. H with shortened bits and
+        // punctured degree-1 bits removed, indexed as H
+        std::vector<std::vector<node>> mCheckN;
+        std::vector<std::vector<node>> mVarN;
+        vec_int mPrunedEdges;
+        int mNNZGraph = 0;
+
+        // checks of the decoding graph partitioned into cache-sized layers
+        mat_int mLayers;
+        u64 mLayerCacheBytes = LAYER_CACHE_BYTES;
+
+        std::vector<bool> mIsShortened;
+        std::vector<bool> mIsPunctured;
+        u64 mRevision = 0;
     };
 
 } // namespace ldpc
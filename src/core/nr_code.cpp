@@ -0,0 +1,231 @@
+#include "nr_code.h"
+
+namespace ldpc
+{
+    namespace
+    {
+        // base of the lifting sets, Z = a * 2^j up to 384 (TS 38.212, Table 5.3.2-1)
+        constexpr int LIFTING_BASE[8] = {2, 3, 5, 7, 9, 11, 13, 15};
+        constexpr int MAX_LIFTING_SIZE = 384;
+
+        // k0 of rv 1..3 as fraction of the full buffer, BG1 of 66Z and BG2 of 50Z (Table 5.4.2.1-2)
+        constexpr int K0_NUM[2][4] = {{0, 17, 33, 56}, {0, 13, 25, 43}};
+        constexpr int K0_DEN[2] = {66, 50};
+
+        // shift tables of the 8 lifting sets from the lines "i j V0 ... V7" of
+        // the nonzero blocks, as laid out in Tables 5.3.2-2/3
+        std::vector<mat_int> read_shifts(const int bg, const std::string &tableFile)
+        {
+            if (bg != 1 && bg != 2)
+                throw std::runtime_error("nr_base_graph: base graph must be 1 or 2");
+
+            const int mb = (bg == 1) ? 46 : 42;
+            const int nb = ((bg == 1) ? 22 : 10) + mb;
+
+            mapped_file file(tableFile);
+            const char *first = file.data();
+            const char *last = file.data() + file.size();
+
+            vec_int values;
+            while (first != last)
+            {
+                if (*first == ' ' || *first == '\t' || *first == '\r' || *first == '\n')
+                {
+                    ++first;
+                    continue;
+                }
+
+                int x;
+                auto [ptr, ec] = std::from_chars(first, last, x);
+                if (ec != std::errc())
+                    throw std::runtime_error("nr_base_graph: invalid entry in shift table file");
+                values.push_back(x);
+                first = ptr;
+            }
+
+            if (values.empty() || values.size() % 10 != 0)
+                throw std::runtime_error("nr_base_graph: shift table lines must hold i, j and 8 values");
+
+            std::vector<mat_int> shifts(8, mat_int(mb, vec_int(nb, -1)));
+            for (std::size_t k = 0; k < values.size(); k += 10)
+            {
+                const int i = values[k];
+                const int j = values[k + 1];
+                if (i < 0 || i >= mb || j < 0 || j >= nb || shifts[0][i][j] >= 0)
+                    throw std::runtime_error("nr_base_graph: invalid or repeated block in shift table file");
+
+                for (int s = 0; s < 8; ++s)
+                {
+                    if (values[k + 2 + s] < 0)
+                        throw std::runtime_error("nr_base_graph: negative shift in shift table file");
+                    shifts[s][i][j] = values[k + 2 + s];
+                }
+            }
+            return shifts;
+        }
+    } // namespace
+
+    nr_base_graph::nr_base_graph(const int bg, const std::string &tableFile)
+        : nr_base_graph(bg, read_shifts(bg, tableFile))
+    {
+    }
+
+    nr_base_graph::nr_base_graph(const int bg, const std::vector<mat_int> &shifts)
+        : mBG(bg),
+          mShifts(shifts)
+    {
+        if (bg != 1 && bg != 2)
+            throw std::runtime_error("nr_base_graph: base graph must be 1 or 2");
+        if (shifts.size() != 1 && shifts.size() != 8)
+            throw std::runtime_error("nr_base_graph: one shift table or one per lifting set required");
+
+        mKb = (bg == 1) ? 22 : 10;
+        mMb = (bg == 1) ? 46 : 42;
+        mNb = mKb + mMb;
+
+        for (const auto &V : mShifts)
+        {
+            if (static_cast<int>(V.size()) != mMb)
+                throw std::runtime_error("nr_base_graph: wrong number of base rows");
+
+            for (int i = 0; i < mMb; ++i)
+            {
+                if (static_cast<int>(V[i].size()) != mNb)
+                    throw std::runtime_error("nr_base_graph: wrong number of base columns");
+
+                // the extension columns are the identity, rows can be dropped with them
+                for (int j = mKb + 4; j < mNb; ++j)
+                {
+                    if ((V[i][j] >= 0) != (j == mKb + i))
+                        throw std::runtime_error("nr_base_graph: extension columns are not the identity");
+                }
+            }
+        }
+    }
+
+    qc_matrix nr_base_graph::lift(const int Z, int rows) const
+    {
+        if (rows < 0)
+            rows = mMb;
+        if (rows < 4 || rows > mMb)
+            throw std::runtime_error("nr_base_graph: invalid number of base rows");
+
+        const auto &V = mShifts[(mShifts.size() == 1) ? 0 : lifting_set(Z)];
+
+        mat_int exponents(rows, vec_int(mKb + rows));
+        for (int i = 0; i < rows; ++i)
+        {
+            for (int j = 0; j < mKb + rows; ++j)
+            {
+                exponents[i][j] = (V[i][j] < 0) ? -1 : V[i][j] % Z;
+            }
+        }
+
+        return qc_matrix(exponents, Z);
+    }
+
+    ldpc_code nr_base_graph::code(const int Z, const int filler, const int E, const int rv) const
+    {
+        lifting_set(Z);
+
+        // codeword without the first 2Z columns, filler bits included
+        const int K = mKb * Z;
+        const int Ncb = (mNb - 2) * Z;
+        if (filler < 0 || filler > K - 2 * Z)
+            throw std::runtime_error("nr_base_graph: invalid number of filler bits");
+
+        const int numBits = (E > 0) ? E : Ncb - filler;
+        if (numBits > Ncb - filler)
+            throw std::runtime_error("nr_base_graph: E exceeds the circular buffer, repetition is not supported");
+
+        auto isFiller = [&](const int j) { return j >= K - filler && j < K; };
+
+        std::vector<bool> transmitted(mNb * Z, false);
+        int lastCol = 0;
+        for (int k = 0, j = k0(Z, rv); k < numBits; ++j)
+        {
+            const int col = 2 * Z + j % Ncb;
+            if (isFiller(col))
+                continue;
+
+            transmitted[col] = true;
+            lastCol = std::max(lastCol, col);
+            ++k;
+        }
+
+        // rows past the last transmitted column only check punctured parity bits
+        const int rows = std::max(4, lastCol / Z - mKb + 1);
+        const int n = (mKb + rows) * Z;
+
+        vec_int puncture, shorten;
+        for (int j = 0; j < n; ++j)
+        {
+            if (isFiller(j))
+                shorten.push_back(j);
+            else if (!transmitted[j])
+                puncture.push_back(j);
+        }
+
+        return ldpc_code(lift(Z, rows), puncture, shorten);
+    }
+
+    int nr_base_graph::k0(const int Z, const int rv) const
+    {
+        if (rv < 0 || rv > 3)
+            throw std::runtime_error("nr_base_graph: redundancy version must be 0 to 3");
+
+        const int Ncb = (mNb - 2) * Z;
+        const int den = K0_DEN[mBG - 1];
+        return (K0_NUM[mBG - 1][rv] * Ncb / (den * Z)) * Z;
+    }
+
+    int nr_base_graph::lifting_set(const int Z)
+    {
+        if (Z > 0 && Z <= MAX_LIFTING_SIZE)
+        {
+            // odd part of Z, the powers of two form the set of base 2
+            int a = Z;
+            while (a % 2 == 0)
+                a /= 2;
+            // Z = 1 is no lifting size, 2^j with j >= 1 belongs to the set of base 2
+            if (a == 1 && Z > 1)
+                a = 2;
+            for (int i = 0; i < 8; ++i)
+            {
+                if (LIFTING_BASE[i] == a)
+                    return i;
+            }
+        }
+        throw std::runtime_error("nr_base_graph: invalid lifting size");
+    }
+
+    const vec_int &nr_base_graph::lifting_sizes()
+    {
+        static const vec_int sizes = []() {
+            vec_int z;
+            for (auto a : LIFTING_BASE)
+            {
+                for (int s = a; s <= MAX_LIFTING_SIZE; s *= 2)
+                    z.push_back(s);
+            }
+            std::sort(z.begin(), z.end());
+            return z;
+        }();
+        return sizes;
+    }
+
+    int nr_base_graph::lifting_size(const int bg, const int K)
+    {
+        // information columns of BG2 shrink for short blocks (TS 38.212, 5.2.2)
+        int kb = 22;
+        if (bg == 2)
+            kb = (K > 640) ? 10 : (K > 560) ? 9 : (K > 192) ? 8 : 6;
+
+        for (auto z : lifting_sizes())
+        {
+            if (kb * z >= K)
+                return z;
+        }
+        throw std::runtime_error("nr_base_graph: too many information bits");
+    }
+} // namespace ldpc
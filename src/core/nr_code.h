@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ldpc.h"
+
+namespace ldpc
+{
+    /**
+     * @brief 5G NR base graph (3GPP TS 38.212, 5.3.2) and the codes lifted
+     * from it, built in memory for any lifting size and rate matching.
+     *
+     * BG1 is 46 x 68 with 22 information columns, BG2 is 42 x 52 with 10.
+     * The first four rows form the core with the double-diagonal parity
+     * part, every further row i adds the degree-1 parity column kb + i.
+     * The shift of a block for lifting size Z is V mod Z, with V taken
+     * from the table of the lifting set of Z.
+     *
+     * The lifting sets and the rate-matching constants are built in. The
+     * shift tables are supplied by the caller, e.g. read once from a copy of
+     * Tables 5.3.2-2/3, and are reused for every code, so codes for any
+     * configuration are built without further file I/O.
+     */
+    class nr_base_graph
+    {
+    public:
+        /**
+         * @brief Construct a base graph from a shift table file laid out as
+         * Tables 5.3.2-2/3, i.e. a line "i j V0 ... V7" per nonzero block
+         * with its V in each of the 8 lifting sets.
+         *
+         * @throw runtime_error if the file can not be parsed or the tables do
+         *        not have the NR dimensions and structure
+         * @param bg Base graph, 1 or 2
+         * @param tableFile Shift table file
+         */
+        nr_base_graph(const int bg, const std::string &tableFile);
+
+        /**
+         * @brief Construct a base graph from its shift tables.
+         *
+         * @throw runtime_error if the tables do not have the NR dimensions and structure
+         * @param bg Base graph, 1 or 2
+         * @param shifts Shift table V of each of the 8 lifting sets, or a single
+         *               table used for all sets, -1 for zero blocks
+         */
+        nr_base_graph(const int bg, const std::vector<mat_int> &shifts);
+
+        /**
+         * @brief Lift the base graph, keeping the first rows only.
+         *
+         * @param Z Lifting size
+         * @param rows Number of base rows, at least 4, -1 for all
+         * @return qc_matrix Rows x (kb + rows) base matrix with lifting size Z
+         */
+        qc_matrix lift(const int Z, int rows = -1) const;
+
+        /**
+         * @brief Build the rate-matched code.
+         *
+         * The filler bits are the last information bits and are shortened.
+         * The first 2Z columns are never transmitted. The E transmitted bits
+         * are read from the circular buffer of the remaining columns,
+         * starting at k0 of the redundancy version and skipping filler bits.
+         * All other columns are punctured, and the base rows past the last
+         * transmitted column are dropped with their degree-1 parity columns.
+         *
+         * @throw runtime_error if Z is no lifting size, or E would repeat bits
+         * @param Z Lifting size
+         * @param filler Number of filler bits
+         * @param E Number of transmitted bits, 0 for all bits of the buffer
+         * @param rv Redundancy version, 0 to 3
+         * @return ldpc_code Code with kb * Z information bits, filler bits included
+         */
+        ldpc_code code(const int Z, const int filler = 0, const int E = 0, const int rv = 0) const;
+
+        /**
+         * @brief Start of a redundancy version in the circular buffer.
+         *
+         * @param Z Lifting size
+         * @param rv Redundancy version, 0 to 3
+         * @return int Position k0, relative to column 2Z
+         */
+        int k0(const int Z, const int rv) const;
+
+        // Index iLS of the lifting set containing Z
+        static int lifting_set(const int Z);
+        // All 51 lifting sizes, ascending
+        static const vec_int &lifting_sizes();
+        // Smallest lifting size for K' information bits (incl. CRC)
+        static int lifting_size(const int bg, const int K);
+
+        int bg() const { return mBG; }
+        int info_cols() const { return mKb; }
+        int base_rows() const { return mMb; }
+        int base_cols() const { return mNb; }
+
+    private:
+        int mBG;
+        int mKb;
+        int mMb;
+        int mNb;
+
+        // shift tables of the lifting sets, one for all if there is only one
+        std::vector<mat_int> mShifts;
+    };
+} // namespace ldpc
@@ -0,0 +1,345 @@
+#include "peg.h"
+
+#include <limits>
+#include <numeric>
+
+namespace ldpc
+{
+    namespace
+    {
+        /**
+         * @brief Tanner graph grown by PEG, with the BFS state of the last search.
+         */
+        class peg_graph
+        {
+        public:
+            peg_graph(const int n, const int m, const vec_int &varDegrees, const peg_param &param)
+                : mVarN(n),
+                  mCheckN(m),
+                  mVarDegrees(varDegrees),
+                  mMaxDepth(param.maxDepth),
+                  mMaxReach(param.maxReach),
+                  mAce(param.ace),
+                  mRNG(param.seed),
+                  mBuckets(1, vec_int(m)),
+                  mBucketPos(m),
+                  mCheckState(m, {0, 0}),
+                  mVarState(n, {0, 0}),
+                  mExcluded(m, 0)
+            {
+                std::iota(mBuckets[0].begin(), mBuckets[0].end(), 0);
+                std::iota(mBucketPos.begin(), mBucketPos.end(), 0);
+            }
+
+            /**
+             * @brief Check for the next edge of variable v.
+             *
+             * @param v Variable node
+             * @param blocked Checks that must not be chosen
+             * @return int Check node
+             */
+            int select(const int v, const vec_int &blocked)
+            {
+                // marks of earlier searches are at most mSearchStart
+                mSearchStart = mLevelMark++;
+
+                // blocked checks count as covered, but the BFS still passes them
+                int numReached = 0;
+                for (auto c : blocked)
+                {
+                    if (!excluded(c))
+                    {
+                        mExcluded[c] = mLevelMark;
+                        ++numReached;
+                    }
+                }
+
+                mFrontier.assign(1, v);
+                mVarState[v] = {mLevelMark, 0};
+
+                for (u32 depth = 0;; ++depth)
+                {
+                    // next level of checks, with the least ACE of their shortest paths
+                    mLevel.clear();
+                    int numExcluded = 0;
+                    ++mLevelMark;
+                    for (auto u : mFrontier)
+                    {
+                        const int ace = mVarState[u].ace;
+                        for (auto c : mVarN[u])
+                        {
+                            auto &state = mCheckState[c];
+                            if (!reached(state))
+                            {
+                                state = {mLevelMark, ace};
+                                mLevel.push_back(c);
+                                numExcluded += excluded(c);
+
+                                // out of budget, the remaining checks are at least this far
+                                if (mMaxReach > 0 && numReached + static_cast<int>(mLevel.size()) - numExcluded >= mMaxReach)
+                                    return unreached();
+                            }
+                            else if (state.mark == mLevelMark)
+                            {
+                                state.ace = std::min(state.ace, ace);
+                            }
+                        }
+                    }
+
+                    // no new checks, the unreached ones are not connected to v
+                    if (mLevel.empty())
+                        return unreached();
+
+                    numReached += mLevel.size() - numExcluded;
+                    if (numReached == num_checks())
+                        return farthest();
+
+                    if (mMaxDepth > 0 && depth + 1 >= mMaxDepth)
+                        return unreached();
+
+                    mNext.clear();
+                    for (auto c : mLevel)
+                    {
+                        const int ace = mCheckState[c].ace;
+                        for (auto u : mCheckN[c])
+                        {
+                            auto &state = mVarState[u];
+                            const int pathAce = mAce ? ace + mVarDegrees[u] - 2 : 0;
+                            if (!reached(state))
+                            {
+                                state = {mLevelMark, pathAce};
+                                mNext.push_back(u);
+                            }
+                            else
+                            {
+                                state.ace = std::min(state.ace, pathAce);
+                            }
+                        }
+                    }
+                    std::swap(mFrontier, mNext);
+                }
+            }
+
+            void connect(const int v, const int c)
+            {
+                mVarN[v].push_back(c);
+                mCheckN[c].push_back(v);
+
+                // move c to the bucket of the next degree
+                const int d = mCheckN[c].size() - 1;
+                auto &from = mBuckets[d];
+                const int last = from.back();
+                from[mBucketPos[c]] = last;
+                mBucketPos[last] = mBucketPos[c];
+                from.pop_back();
+
+                if (static_cast<int>(mBuckets.size()) <= d + 1)
+                    mBuckets.push_back(vec_int());
+                mBucketPos[c] = mBuckets[d + 1].size();
+                mBuckets[d + 1].push_back(c);
+            }
+
+            int num_checks() const { return mCheckN.size(); }
+            const std::vector<vec_int> &var_neighbor() const { return mVarN; }
+
+        private:
+            // unreached check of minimum degree, random among those
+            int unreached() { return min_degree(true); }
+
+            int min_degree(const bool unreachedOnly)
+            {
+                for (const auto &bucket : mBuckets)
+                {
+                    if (bucket.empty())
+                        continue;
+
+                    const int start = mRNG() % bucket.size();
+                    for (u64 k = 0; k < bucket.size(); ++k)
+                    {
+                        const int c = bucket[(start + k) % bucket.size()];
+                        if (!excluded(c) && !(unreachedOnly && reached(mCheckState[c])))
+                            return c;
+                    }
+                }
+
+                if (!unreachedOnly)
+                    throw std::runtime_error("peg: no check left to connect");
+                return farthest();
+            }
+
+            // check of the last level with minimum degree, then maximum ACE, random among those
+            int farthest()
+            {
+                int best = -1;
+                int bestDegree = std::numeric_limits<int>::max();
+                int bestAce = std::numeric_limits<int>::min();
+                int ties = 0;
+                for (auto c : mLevel)
+                {
+                    if (excluded(c))
+                        continue;
+
+                    const int d = mCheckN[c].size();
+                    const int ace = mCheckState[c].ace;
+                    if (d < bestDegree || (d == bestDegree && ace > bestAce))
+                    {
+                        best = c;
+                        bestDegree = d;
+                        bestAce = ace;
+                        ties = 1;
+                    }
+                    else if (d == bestDegree && ace == bestAce && mRNG() % ++ties == 0)
+                    {
+                        best = c;
+                    }
+                }
+
+                // only blocked checks in the last level
+                if (best < 0)
+                    return min_degree(false);
+                return best;
+            }
+
+            std::vector<vec_int> mVarN;
+            std::vector<vec_int> mCheckN;
+            const vec_int &mVarDegrees;
+            u32 mMaxDepth;
+            int mMaxReach;
+            bool mAce;
+            std::mt19937_64 mRNG;
+
+            // checks by degree, with their position in the bucket
+            std::vector<vec_int> mBuckets;
+            vec_int mBucketPos;
+
+            // BFS state of a node, i.e. the level it was reached in and the
+            // least ACE of a shortest path from the searched variable
+            struct node_state
+            {
+                u32 mark;
+                int ace;
+            };
+
+            // levels are numbered across searches, so nothing is cleared between them
+            bool reached(const node_state &s) const { return s.mark > mSearchStart; }
+            bool excluded(const int c) const { return mExcluded[c] == mSearchStart + 1; }
+
+            u32 mSearchStart = 0;
+            u32 mLevelMark = 0;
+            std::vector<node_state> mCheckState;
+            std::vector<node_state> mVarState;
+            std::vector<u32> mExcluded;
+
+            vec_int mFrontier;
+            vec_int mNext;
+            vec_int mLevel;
+        };
+
+        // variables in order of ascending degree, ties in index order
+        vec_int peg_order(const vec_int &degrees)
+        {
+            vec_int order(degrees.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&degrees](int a, int b) { return degrees[a] < degrees[b]; });
+            return order;
+        }
+    } // namespace
+
+    vec_int degree_sequence(const int n, const std::vector<std::pair<int, double>> &dist)
+    {
+        auto sorted = dist;
+        std::sort(sorted.begin(), sorted.end());
+
+        vec_int degrees;
+        degrees.reserve(n);
+        double cumulative = 0;
+        for (const auto &d : sorted)
+        {
+            if (d.first < 1 || d.second < 0)
+                throw std::runtime_error("degree_sequence: invalid degree distribution");
+
+            cumulative += d.second;
+            const int count = std::min<int>(n, std::lround(cumulative * n)) - degrees.size();
+            degrees.insert(degrees.end(), std::max(count, 0), d.first);
+        }
+
+        if (sorted.empty())
+            throw std::runtime_error("degree_sequence: empty degree distribution");
+        degrees.resize(n, sorted.back().first);
+        return degrees;
+    }
+
+    sparse_csr<bits_t> peg(const int m, const vec_int &varDegrees, const peg_param &param)
+    {
+        const int n = varDegrees.size();
+        for (auto d : varDegrees)
+        {
+            if (d < 1 || d > m)
+                throw std::runtime_error("peg: variable degree out of range");
+        }
+
+        peg_graph graph(n, m, varDegrees, param);
+        const vec_int none;
+        for (auto v : peg_order(varDegrees))
+        {
+            for (int k = 0; k < varDegrees[v]; ++k)
+            {
+                graph.connect(v, graph.select(v, none));
+            }
+        }
+
+        std::vector<edge<bits_t>> edges;
+        for (int j = 0; j < n; ++j)
+        {
+            for (auto c : graph.var_neighbor()[j])
+                edges.push_back(edge<bits_t>({c, j, 1}));
+        }
+        std::sort(edges.begin(), edges.end(), [](const auto &a, const auto &b) {
+            return a.rowIndex < b.rowIndex || (a.rowIndex == b.rowIndex && a.colIndex < b.colIndex);
+        });
+
+        return sparse_csr<bits_t>(m, n, edges);
+    }
+
+    qc_matrix qc_peg(const int mb, const vec_int &baseDegrees, const int Z, const peg_param &param)
+    {
+        if (Z < 1)
+            throw std::runtime_error("qc_peg: lifting size must be positive");
+
+        const int nb = baseDegrees.size();
+        for (auto d : baseDegrees)
+        {
+            if (d < 1 || d > mb)
+                throw std::runtime_error("qc_peg: base degree out of range");
+        }
+
+        // ACE uses the degree of each lifted variable
+        vec_int varDegrees(nb * Z);
+        for (int j = 0; j < nb; ++j)
+            std::fill(varDegrees.begin() + j * Z, varDegrees.begin() + (j + 1) * Z, baseDegrees[j]);
+
+        peg_graph graph(nb * Z, mb * Z, varDegrees, param);
+        mat_int exponents(mb, vec_int(nb, -1));
+        vec_int blocked;
+        for (auto j : peg_order(baseDegrees))
+        {
+            blocked.clear();
+            for (int k = 0; k < baseDegrees[j]; ++k)
+            {
+                const int c = graph.select(j * Z, blocked);
+                const int i = c / Z;
+
+                // row r = c mod Z of the circulant holds column 0, i.e. (r + s) mod Z = 0
+                const int s = (Z - c % Z) % Z;
+                exponents[i][j] = s;
+                for (int r = 0; r < Z; ++r)
+                    graph.connect(j * Z + (r + s) % Z, i * Z + r);
+
+                for (int r = 0; r < Z; ++r)
+                    blocked.push_back(i * Z + r);
+            }
+        }
+
+        return qc_matrix(exponents, Z);
+    }
+} // namespace ldpc
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "functions.h"
+#include "qc_matrix.h"
+
+namespace ldpc
+{
+    struct
+    {
+        u64 seed;
+        u32 maxDepth; // BFS depth in check levels, 0 for unlimited
+        u32 maxReach; // checks a BFS may reach before it stops, 0 for unlimited
+        bool ace;     // break ties by the approximate cycle EMD (ACE)
+    } typedef peg_param;
+
+    /**
+     * @brief Variable degrees of n nodes with the given node-perspective
+     * degree distribution, ascending. Rounding is absorbed by the last degree.
+     *
+     * @param n Number of variable nodes
+     * @param dist Pairs of degree and fraction of nodes
+     * @return vec_int Degree of each variable node
+     */
+    vec_int degree_sequence(const int n, const std::vector<std::pair<int, double>> &dist);
+
+    /**
+     * @brief Progressive edge growth (Hu, Eleftheriou, Arnold).
+     *
+     * The variables are connected in order of ascending degree, each edge
+     * to a check of minimum degree among those at maximum distance, found
+     * by a BFS over the graph grown so far. Visited nodes are marked with
+     * the BFS level they were reached in, numbered across searches, so
+     * nothing is cleared between searches, and checks are kept in buckets
+     * of equal degree, so an unreached check of minimum degree is found
+     * without scanning all checks.
+     *
+     * A full BFS costs O(edges) per edge, i.e. classical PEG is quadratic.
+     * For large codes the search is cut by depth or by the number of
+     * reached checks, and the edge goes to an unreached check of minimum
+     * degree; the cycles it closes are still longer than the search depth.
+     *
+     * With ACE, remaining ties go to the check closing the cycle of
+     * largest ACE, i.e. sum of degree - 2 of its variables (Xiao,
+     * Banihashemi); otherwise and then, ties are broken at random.
+     *
+     * @throw runtime_error if a degree exceeds the number of checks
+     * @param m Number of checks
+     * @param varDegrees Degree of each variable node
+     * @param param Construction parameters
+     * @return sparse_csr<bits_t> Parity-check matrix
+     */
+    sparse_csr<bits_t> peg(const int m, const vec_int &varDegrees, const peg_param &param);
+
+    /**
+     * @brief Quasi-cyclic PEG.
+     *
+     * PEG on the lifted graph, where only the first variable of each base
+     * column is connected and a whole circulant is placed per edge: the
+     * chosen check fixes both the base row and the shift. Base rows already
+     * connected to the base column are excluded.
+     *
+     * @throw runtime_error if a degree exceeds the number of base rows
+     * @param mb Number of base rows
+     * @param baseDegrees Degree of each base column
+     * @param Z Lifting size
+     * @param param Construction parameters
+     * @return qc_matrix Base matrix with lifting size Z
+     */
+    qc_matrix qc_peg(const int mb, const vec_int &baseDegrees, const int Z, const peg_param &param);
+} // namespace ldpc
@@ -0,0 +1,118 @@
+#include "qc_matrix.h"
+
+namespace ldpc
+{
+    qc_matrix::qc_matrix(const mat_int &exponents, const int Z)
+        : mMb(exponents.size()),
+          mNb(exponents.empty() ? 0 : exponents[0].size()),
+          mZ(Z),
+          mExp(exponents)
+    {
+        index();
+    }
+
+    void qc_matrix::index()
+    {
+        if (mZ < 1)
+            throw std::runtime_error("qc_matrix: lifting size must be positive");
+
+        mRowBlocks = std::vector<std::vector<std::pair<int, int>>>(mMb);
+        mNumBlocks = 0;
+        for (int br = 0; br < mMb; ++br)
+        {
+            if (static_cast<int>(mExp[br].size()) != mNb)
+                throw std::runtime_error("qc_matrix: base rows differ in length");
+
+            for (int bc = 0; bc < mNb; ++bc)
+            {
+                const int s = mExp[br][bc];
+                if (s < -1)
+                    throw std::runtime_error("qc_matrix: invalid exponent");
+                if (s < 0)
+                    continue;
+
+                mRowBlocks[br].push_back(std::make_pair(bc, s % mZ));
+                ++mNumBlocks;
+            }
+        }
+    }
+
+    void qc_matrix::read_from_file(const std::string &filename)
+    {
+        mapped_file file(filename);
+        parse(file.data(), file.data() + file.size());
+    }
+
+    void qc_matrix::parse(const char *first, const char *last)
+    {
+        vec_int values;
+        while (first != last)
+        {
+            if (*first == ' ' || *first == '\t' || *first == '\r' || *first == '\n')
+            {
+                ++first;
+                continue;
+            }
+
+            int x;
+            auto [ptr, ec] = std::from_chars(first, last, x);
+            if (ec != std::errc())
+                throw std::runtime_error("qc_matrix: invalid entry in base matrix file");
+            values.push_back(x);
+            first = ptr;
+        }
+
+        if (values.size() < 3)
+            throw std::runtime_error("qc_matrix: missing dimensions");
+
+        mNb = values[0];
+        mMb = values[1];
+        mZ = values[2];
+        if (mNb < 1 || mMb < 1 || static_cast<u64>(mNb) * mMb + 3 != values.size())
+            throw std::runtime_error("qc_matrix: base matrix does not match its dimensions");
+
+        mExp = mat_int(mMb, vec_int(mNb));
+        for (int br = 0; br < mMb; ++br)
+        {
+            std::copy(values.begin() + 3 + br * mNb, values.begin() + 3 + (br + 1) * mNb, mExp[br].begin());
+        }
+
+        index();
+    }
+
+    sparse_csr<bits_t> qc_matrix::expand() const
+    {
+        std::vector<edge<bits_t>> edges;
+        edges.reserve(nnz());
+
+        // row r of a block holds column (r + s) mod Z, the edges are numbered row by row
+        for (int br = 0; br < mMb; ++br)
+        {
+            for (int r = 0; r < mZ; ++r)
+            {
+                for (const auto &b : mRowBlocks[br])
+                    edges.push_back(edge<bits_t>({br * mZ + r, b.first * mZ + (r + b.second) % mZ, 1}));
+            }
+        }
+
+        return sparse_csr<bits_t>(num_rows(), num_cols(), edges);
+    }
+
+    void qc_matrix::save(binary_writer &out) const
+    {
+        out.put(mMb);
+        out.put(mNb);
+        out.put(mZ);
+        out.put(mExp);
+    }
+
+    void qc_matrix::load(binary_reader &in)
+    {
+        in.get(mMb);
+        in.get(mNb);
+        in.get(mZ);
+        in.get(mExp);
+        if (mZ > 0)
+            index();
+    }
+} // namespace ldpc
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "functions.h"
+
+namespace ldpc
+{
+    /**
+     * @brief Quasi-cyclic parity-check matrix in its compact base-matrix form.
+     *
+     * Each entry of the mb x nb exponent matrix is a Z x Z block, -1 for
+     * the all-zero block and s for the identity shifted by s, i.e. row r
+     * of the block holds column (r + s) mod Z.
+     *
+     * The file format is a line "nb mb Z" followed by the mb rows of the
+     * exponent matrix.
+     */
+    class qc_matrix
+    {
+    public:
+        qc_matrix() = default;
+
+        /**
+         * @brief Construct a QC matrix from its exponents.
+         *
+         * @throw runtime_error
+         * @param exponents Exponent matrix, -1 for zero blocks
+         * @param Z Lifting size
+         */
+        qc_matrix(const mat_int &exponents, const int Z);
+
+        void read_from_file(const std::string &filename);
+        void parse(const char *first, const char *last);
+
+        // Expand to the lifted sparse matrix
+        sparse_csr<bits_t> expand() const;
+
+        void save(binary_writer &out) const;
+        void load(binary_reader &in);
+
+        int num_rows() const { return mMb * mZ; }
+        int num_cols() const { return mNb * mZ; }
+        u64 nnz() const { return static_cast<u64>(mNumBlocks) * mZ; }
+        bool empty() const { return mZ == 0; }
+
+        int base_rows() const { return mMb; }
+        int base_cols() const { return mNb; }
+        int lift() const { return mZ; }
+        const mat_int &exponents() const { return mExp; }
+
+    private:
+        void index();
+
+        int mMb = 0;
+        int mNb = 0;
+        int mZ = 0;
+        mat_int mExp;
+
+        // non-zero blocks of each base row as (base column, shift)
+        std::vector<std::vector<std::pair<int, int>>> mRowBlocks;
+        int mNumBlocks = 0;
+    };
+} // namespace ldpc
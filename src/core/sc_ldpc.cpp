@@ -0,0 +1,78 @@
+#include "sc_ldpc.h"
+
+namespace ldpc
+{
+    sc_ldpc_code::sc_ldpc_code(const std::vector<std::string> &componentFiles, const int chainLength)
+        : mChainLength(chainLength)
+    {
+        try
+        {
+            for (const auto &file : componentFiles)
+            {
+                mComponents.push_back(sparse_csr<bits_t>());
+                mComponents.back().read_from_file(file, 0);
+            }
+            check_components();
+        }
+        catch (std::exception &e)
+        {
+            std::cout << "Error: sc_ldpc_code(): " << e.what() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    sc_ldpc_code::sc_ldpc_code(const std::vector<sparse_csr<bits_t>> &components, const int chainLength)
+        : mChainLength(chainLength),
+          mComponents(components)
+    {
+        check_components();
+    }
+
+    void sc_ldpc_code::check_components()
+    {
+        if (mComponents.empty())
+            throw std::runtime_error("no component matrices given");
+        if (mChainLength < 1)
+            throw std::runtime_error("chain length must be positive");
+
+        mEdgeOffset = vec_int(1, 0);
+        for (const auto &h : mComponents)
+        {
+            if (h.num_cols() != nb() || h.num_rows() != mb())
+                throw std::runtime_error("component matrices differ in size");
+
+            mEdgeOffset.push_back(mEdgeOffset.back() + h.nz_entry().size());
+        }
+    }
+
+    sparse_csr<bits_t> sc_ldpc_code::expand() const
+    {
+        std::vector<edge<bits_t>> edges;
+        edges.reserve(static_cast<u64>(mChainLength) * nnz_position());
+
+        for (int j = 0; j < mChainLength; ++j)
+        {
+            for (int k = 0; k <= coupling_width(); ++k)
+            {
+                for (const auto &e : mComponents[k].nz_entry())
+                {
+                    edges.push_back(edge<bits_t>({(j + k) * mb() + e.rowIndex, j * nb() + e.colIndex, e.value}));
+                }
+            }
+        }
+
+        return sparse_csr<bits_t>(mc(), nc(), edges);
+    }
+
+    std::ostream &operator<<(std::ostream &os, const sc_ldpc_code &code)
+    {
+        os << "Coupling width : " << code.coupling_width() << "\n";
+        os << "Chain length : " << code.chain_length() << "\n";
+        os << "N (position) : " << code.nb() << "\n";
+        os << "M (position) : " << code.mb() << "\n";
+        os << "N : " << code.nc() << "\n";
+        os << "M : " << code.mc() << "\n";
+        os << "Rate : " << 1. - static_cast<double>(code.mc()) / static_cast<double>(code.nc()) << "\n";
+        return os;
+    }
+} // namespace ldpc
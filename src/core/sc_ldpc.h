@@ -0,0 +1,67 @@
+#pragma once
+
+#include "functions.h"
+
+namespace ldpc
+{
+    /**
+     * @brief Spatially-coupled LDPC code, i.e. a chain of L positions coupled
+     * by the component matrices H_0, ..., H_w. Block row t and block column j
+     * of the coupled parity-check matrix hold H_{t-j} if 0 <= t-j <= w.
+     *
+     */
+    class sc_ldpc_code
+    {
+    public:
+        /**
+         * @brief Construct a new sc ldpc code object.
+         *
+         * @param componentFiles Component matrix files H_0, ..., H_w
+         * @param chainLength Number of coupled positions L
+         */
+        sc_ldpc_code(const std::vector<std::string> &componentFiles, const int chainLength);
+
+        /**
+         * @brief Construct a new sc ldpc code object.
+         *
+         * @param components Component matrices H_0, ..., H_w
+         * @param chainLength Number of coupled positions L
+         */
+        sc_ldpc_code(const std::vector<sparse_csr<bits_t>> &components, const int chainLength);
+
+        /**
+         * @brief Expand the coupled parity-check matrix of the whole chain.
+         *
+         * @return sparse_csr<bits_t> Coupled parity-check matrix
+         */
+        sparse_csr<bits_t> expand() const;
+
+        friend std::ostream &operator<<(std::ostream &os, const sc_ldpc_code &code);
+
+        // Coupling width w
+        int coupling_width() const { return mComponents.size() - 1; }
+        // Number of coupled positions L
+        int chain_length() const { return mChainLength; }
+        // Number of columns per position
+        int nb() const { return mComponents[0].num_cols(); }
+        // Number of rows per position
+        int mb() const { return mComponents[0].num_rows(); }
+        // Number of columns of the chain
+        int nc() const { return mChainLength * nb(); }
+        // Number of rows of the chain, including termination
+        int mc() const { return (mChainLength + coupling_width()) * mb(); }
+        // Number of edges of one block row, i.e. over all components
+        int nnz_position() const { return mEdgeOffset.back(); }
+        // Component matrices H_0, ..., H_w
+        const std::vector<sparse_csr<bits_t>> &components() const { return mComponents; }
+        // Offset of the edges of component k within one block row
+        const vec_int &edge_offset() const { return mEdgeOffset; }
+
+    private:
+        void check_components();
+
+        int mChainLength;
+        std::vector<sparse_csr<bits_t>> mComponents;
+        vec_int mEdgeOffset;
+    };
+} // namespace ldpc
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <vector>
-#include <forward_list>
 #include <iostream>
 #include <sstream>
-#include <map>
+#include <algorithm>
+#include <charconv>
+
+#include "binary_io.h"
 
 namespace ldpc
 {
@@ -22,6 +24,16 @@ namespace ldpc
         int edgeIndex;
     };
 
+    /**
+     * @brief Rank over gf(2) of the matrix given by its row neighbours,
+     * implemented in bit_matrix.cpp.
+     * 
+     * @param rowN Column indices of each row
+     * @param numCols Number of columns
+     * @return int Rank
+     */
+    int gf2_rank(const std::vector<std::vector<node>> &rowN, const int numCols);
+
     /**
      * @brief Sparse matrix with minimal functionality required for encoding/decoding
      * LDPC codes and other linear block codes.
@@ -40,8 +52,11 @@ namespace ldpc
               rowN(numRows, std::vector<node>())
         {
         }
+        sparse_csr(const int m, const int n, const std::vector<edge<T>> &edges);
 
         void read_from_file(const std::string &filename, int skipLines);
+        void parse(const char *first, const char *last);
+        void parse_alist(const char *first, const char *last);
 
         void multiply_left(const std::vector<T> &left, std::vector<T> &result) const; // for encoding
         std::vector<T> multiply_left(const std::vector<T> &left) const;
@@ -63,23 +78,83 @@ namespace ldpc
         bool empty() const { return ((numCols == 0) && (numRows == 0)); }
         int rank() const;
 
-        // operations for gaussian elimination on sparse matrices over gf(2)
+        // Edge index of entry (row, col), -1 if it is zero
+        int find_entry(const int row, const int col) const;
+        // Append a non-zero entry, returns its edge index
+        int add_entry(const int row, const int col, const T value);
+        // Remove a non-zero entry, the last edge takes over its edge index, which is returned
+        int remove_entry(const int row, const int col);
 
-        static void swap_rows(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int i, const int j);
-        static void swap_cols(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int i, const int j);
-        static void add_rows(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int dest, const int src);
-        static void add_cols(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int dest, const int src);
-        static void zero_row(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int m);
-        static void zero_col(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int n);
+        // Binary (de)serialization of all arrays, see ldpc_code cache
+        void save(binary_writer &out) const;
+        void load(binary_reader &in);
 
     private:
-        int numCols;                         // number of columns
-        int numRows;                         // number of rows
+        void build_neighbors();
+
+        int numCols = 0;                     // number of columns
+        int numRows = 0;                     // number of rows
         std::vector<std::vector<node>> colN; // column neighbors, with row and edge index
         std::vector<std::vector<node>> rowN; // row neigbors, with col and edge index
         std::vector<edge<T>> nonZeroVals;    // edges, i.e. non-zero entries with row and col index
     };
 
+    /**
+     * @brief Construct a sparse matrix from its non-zero entries.
+     * 
+     * @tparam T finite field
+     * @param m Number of rows
+     * @param n Number of columns
+     * @param edges Non-zero entries
+     */
+    template <typename T>
+    sparse_csr<T>::sparse_csr(const int m, const int n, const std::vector<edge<T>> &edges)
+        : numCols(n),
+          numRows(m),
+          nonZeroVals(edges)
+    {
+        for (const auto &e : nonZeroVals)
+        {
+            if (e.rowIndex < 0 || e.rowIndex >= numRows || e.colIndex < 0 || e.colIndex >= numCols)
+                throw std::runtime_error("sparse_csr(): entry index out of range");
+        }
+
+        build_neighbors();
+    }
+
+    /**
+     * @brief Build the row and column neighbours from the non-zero entries,
+     * counted first so each neighbour list is allocated once. Neighbours
+     * keep the order of the entries.
+     * 
+     * @tparam T finite field
+     */
+    template <typename T>
+    void sparse_csr<T>::build_neighbors()
+    {
+        std::vector<int> colCount(numCols, 0);
+        std::vector<int> rowCount(numRows, 0);
+        for (const auto &e : nonZeroVals)
+        {
+            ++colCount[e.colIndex];
+            ++rowCount[e.rowIndex];
+        }
+
+        colN = std::vector<std::vector<node>>(numCols);
+        rowN = std::vector<std::vector<node>>(numRows);
+        for (int j = 0; j < numCols; ++j)
+            colN[j].reserve(colCount[j]);
+        for (int i = 0; i < numRows; ++i)
+            rowN[i].reserve(rowCount[i]);
+
+        for (int i = 0; i < static_cast<int>(nonZeroVals.size()); ++i)
+        {
+            const auto &e = nonZeroVals[i];
+            colN[e.colIndex].push_back(node({e.rowIndex, i}));
+            rowN[e.rowIndex].push_back(node({e.colIndex, i}));
+        }
+    }
+
     /**
      * @brief Read a sparse CSR file.
      * 
@@ -91,65 +166,251 @@ namespace ldpc
     template <typename T>
     void sparse_csr<T>::read_from_file(const std::string &filename, int skipLines)
     {
-        int index = 0;
-
-        std::ifstream infile(filename);
-        std::string line;
+        mapped_file file(filename);
+        const char *first = file.data();
+        const char *last = first + file.size();
 
-        if (!infile.good())
-            throw std::runtime_error("can not open file for reading");
+        // skip lines at beginning of file
+        while (skipLines-- > 0 && first != last)
+        {
+            first = std::find(first, last, '\n');
+            if (first != last)
+                ++first;
+        }
 
-        std::map<int, std::vector<node>> cols;
-        std::map<int, std::vector<node>> rows;
+        parse(first, last);
+    }
 
+    /**
+     * @brief Parse the non-zero entries of a sparse CSR file from memory,
+     * one "row col [value]" per line, value in 1..q-1. The dimensions
+     * follow from the largest indices.
+     * 
+     * @throw runtime_error
+     * @tparam T finite field
+     * @param first First character
+     * @param last One past the last character
+     */
+    template <typename T>
+    void sparse_csr<T>::parse(const char *first, const char *last)
+    {
         numCols = 0;
         numRows = 0;
         nonZeroVals.clear();
 
-        // skip lines at beginning of file
-        while (skipLines-- > 0)
+        int values[3];
+        while (first != last)
         {
-            std::getline(infile, line);
-        }
+            int count = 0;
+            while (first != last && *first != '\n')
+            {
+                if (*first == ' ' || *first == '\t' || *first == '\r')
+                {
+                    ++first;
+                    continue;
+                }
+
+                int x;
+                auto [ptr, ec] = std::from_chars(first, last, x);
+                if (ec != std::errc() || x < 0)
+                    throw std::runtime_error("invalid entry in sparse matrix file");
+                if (count < 3)
+                    values[count] = x;
+                ++count;
+                first = ptr;
+            }
+            if (first != last)
+                ++first;
+
+            if (count == 0)
+                continue;
+            if (count < 2)
+                throw std::runtime_error("invalid entry in sparse matrix file");
+
+            // a given value must be a non-zero field element, 1 if no value is given
+            if (count > 2 && (values[2] == 0 || values[2] >= T::q))
+                throw std::runtime_error("invalid value in sparse matrix file");
 
-        while (getline(infile, line))
-        {
             edge<T> entry;
+            entry.rowIndex = values[0];
+            entry.colIndex = values[1];
+            entry.value = (count > 2) ? T(values[2]) : T(1);
+            nonZeroVals.push_back(entry);
 
-            std::istringstream record(line);
-            record >> entry.rowIndex;
-            record >> entry.colIndex;
-            record >> entry.value;
+            // find the number of columns and rows from indices
+            numCols = std::max(numCols, entry.colIndex + 1);
+            numRows = std::max(numRows, entry.rowIndex + 1);
+        }
 
-            // no value is given
-            if (entry.value == 0)
+        build_neighbors();
+    }
+
+    /**
+     * @brief Parse a matrix in alist format from memory: "n m", the maximum
+     * column and row degrees, the n column and m row degrees, then one line
+     * of 1-based neighbours per column and per row, padded with zeros.
+     * The entries are taken from the row lines.
+     * 
+     * @throw runtime_error
+     * @tparam T finite field
+     * @param first First character
+     * @param last One past the last character
+     */
+    template <typename T>
+    void sparse_csr<T>::parse_alist(const char *first, const char *last)
+    {
+        std::vector<std::vector<int>> lines;
+        while (first != last)
+        {
+            std::vector<int> line;
+            while (first != last && *first != '\n')
             {
-                entry.value = T(1);
+                if (*first == ' ' || *first == '\t' || *first == '\r')
+                {
+                    ++first;
+                    continue;
+                }
+
+                int x;
+                auto [ptr, ec] = std::from_chars(first, last, x);
+                if (ec != std::errc() || x < 0)
+                    throw std::runtime_error("invalid entry in alist file");
+                line.push_back(x);
+                first = ptr;
             }
+            if (first != last)
+                ++first;
 
-            nonZeroVals.push_back(entry);
+            if (!line.empty())
+                lines.push_back(line);
+        }
 
-            cols[entry.colIndex].push_back(node({entry.rowIndex, index}));
-            rows[entry.rowIndex].push_back(node({entry.colIndex, index}));
+        if (lines.size() < 4 || lines[0].size() != 2)
+            throw std::runtime_error("alist file: missing dimensions");
 
-            // find the number of columns and rows from indices
-            numCols = std::max(numCols, entry.colIndex);
-            numRows = std::max(numRows, entry.rowIndex);
+        numCols = lines[0][0];
+        numRows = lines[0][1];
+        if (static_cast<int>(lines.size()) != 4 + numCols + numRows ||
+            static_cast<int>(lines[2].size()) != numCols || static_cast<int>(lines[3].size()) != numRows)
+            throw std::runtime_error("alist file: number of lines does not match the dimensions");
+
+        nonZeroVals.clear();
+        for (int i = 0; i < numRows; ++i)
+        {
+            int degree = 0;
+            for (auto j : lines[4 + numCols + i])
+            {
+                if (j == 0)
+                    continue; // padding
+                if (j > numCols)
+                    throw std::runtime_error("alist file: column index out of range");
+
+                nonZeroVals.push_back(edge<T>({i, j - 1, T(1)}));
+                ++degree;
+            }
 
-            ++index;
+            if (degree != lines[3][i])
+                throw std::runtime_error("alist file: row degree mismatch");
         }
 
-        ++numCols;
-        ++numRows;
+        build_neighbors();
+
+        for (int j = 0; j < numCols; ++j)
+        {
+            if (static_cast<int>(colN[j].size()) != lines[2][j])
+                throw std::runtime_error("alist file: column degree mismatch");
+        }
+    }
+
+    /**
+     * @brief Find a non-zero entry by scanning the shorter of its row and column.
+     * 
+     * @tparam T finite field
+     * @param row Row index
+     * @param col Column index
+     * @return int Edge index, -1 if the entry is zero
+     */
+    template <typename T>
+    int sparse_csr<T>::find_entry(const int row, const int col) const
+    {
+        if (row < 0 || row >= numRows || col < 0 || col >= numCols)
+            return -1;
+
+        const bool byRow = rowN[row].size() <= colN[col].size();
+        for (const auto &n : byRow ? rowN[row] : colN[col])
+        {
+            if (n.nodeIndex == (byRow ? col : row))
+                return n.edgeIndex;
+        }
+        return -1;
+    }
 
-        colN = std::vector<std::vector<node>>(numCols, std::vector<node>());
-        rowN = std::vector<std::vector<node>>(numRows, std::vector<node>());
+    /**
+     * @brief Append a non-zero entry. Existing edge indices are kept.
+     * 
+     * @throw runtime_error if the entry is out of range or already non-zero
+     * @tparam T finite field
+     * @param row Row index
+     * @param col Column index
+     * @param value Value of the entry
+     * @return int Edge index of the entry, i.e. the last one
+     */
+    template <typename T>
+    int sparse_csr<T>::add_entry(const int row, const int col, const T value)
+    {
+        if (row < 0 || row >= numRows || col < 0 || col >= numCols)
+            throw std::runtime_error("sparse_csr: entry index out of range");
+        if (find_entry(row, col) >= 0)
+            throw std::runtime_error("sparse_csr: entry is already non-zero");
+
+        const int e = nonZeroVals.size();
+        nonZeroVals.push_back(edge<T>({row, col, value}));
+        rowN[row].push_back(node({col, e}));
+        colN[col].push_back(node({row, e}));
+        return e;
+    }
 
-        // copy assign the elements of the map to the vector
-        for (auto e : cols)
-            colN[e.first] = e.second;
-        for (auto e : rows)
-            rowN[e.first] = e.second;
+    /**
+     * @brief Remove a non-zero entry. The last edge is moved to the edge
+     * index of the removed one, so all other edge indices are kept.
+     * 
+     * @throw runtime_error if the entry is zero
+     * @tparam T finite field
+     * @param row Row index
+     * @param col Column index
+     * @return int Edge index of the removed entry, now the one of the former last edge
+     */
+    template <typename T>
+    int sparse_csr<T>::remove_entry(const int row, const int col)
+    {
+        const int e = find_entry(row, col);
+        if (e < 0)
+            throw std::runtime_error("sparse_csr: entry is zero");
+
+        auto erase = [](std::vector<node> &n, const int edgeIndex) {
+            n.erase(std::find_if(n.begin(), n.end(), [edgeIndex](const node &x) { return x.edgeIndex == edgeIndex; }));
+        };
+        erase(rowN[row], e);
+        erase(colN[col], e);
+
+        const int last = nonZeroVals.size() - 1;
+        if (e != last)
+        {
+            const auto &moved = nonZeroVals[last];
+            for (auto &n : rowN[moved.rowIndex])
+            {
+                if (n.edgeIndex == last)
+                    n.edgeIndex = e;
+            }
+            for (auto &n : colN[moved.colIndex])
+            {
+                if (n.edgeIndex == last)
+                    n.edgeIndex = e;
+            }
+            nonZeroVals[e] = moved;
+        }
+        nonZeroVals.pop_back();
+        return e;
     }
 
     /**
@@ -220,152 +481,35 @@ namespace ldpc
         return result;
     }
 
-    /**
-     * @brief Calculate rank over gf(2)
-     * 
-     * @tparam T finite field gf(2)
-     * @return int Rank
-     */
-    template<typename T>
-    int sparse_csr<T>::rank() const
-    {
-        int rank = num_cols();
-
-        std::vector<std::forward_list<int>> checkNodeN(num_rows()); // direct check node neighbourhood with node oriented index
-        std::vector<std::forward_list<int>> varNodeN(num_cols());// direct variable node neighbourhood with node oriented index
-
-        for (int i = 0; i < num_rows(); ++i)
-        {
-            for (auto r : row_neighbor()[i]) 
-                checkNodeN[i].push_front(r.nodeIndex);
-        }
-
-        for (int j = 0; j < num_cols(); ++j)
-        {
-            for (auto c : col_neighbor()[j]) 
-                varNodeN[j].push_front(c.nodeIndex);
-        }
-        
-        for (int row = 0; row < rank; ++row)
-        {
-            // check what value h[row][row] has
-            auto it = std::find(varNodeN[row].begin(), varNodeN[row].end(), row);
-            if (it != varNodeN[row].end()) // values is non-zero
-            {
-                // now add current row to all rows where a non-zero entry is in the current col, to remove 1
-                auto vn = varNodeN[row];
-                for (auto ri : vn)
-                {
-                    if (ri > row)
-                    {
-                        sparse_csr<T>::add_rows(checkNodeN, varNodeN, ri, row);
-                    }
-                }
-            }
-            else // value is zero
-            {
-                // if there is a row below it with non-zero entry in same col, swap current rows
-                bool isZero = true;
-                // find first row with non-zero entry
-                for (auto ri : varNodeN[row])
-                {
-                    if (ri > row)
-                    {
-                        sparse_csr<T>::swap_rows(checkNodeN, varNodeN, ri, row);
-                        isZero = false;
-                        break;
-                    }
-                }
-
-                // if all elements in current col below h[row][row] are zero, swap col it with rank-1 col
-                if (isZero)
-                {
-                    --rank;
-                    // copy last col
-                    sparse_csr<T>::zero_col(checkNodeN, varNodeN, row);
-                    sparse_csr<T>::add_cols(checkNodeN, varNodeN, row, rank);
-                }
-
-                --row;
-            }
-        }
-        
-        return rank;
-    }
-
-    template<typename T>
-    void sparse_csr<T>::swap_rows(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int first, const int second)
-    {
-        sparse_csr<T>::add_rows(checkNodeN, varNodeN, first, second);
-        sparse_csr<T>::add_rows(checkNodeN, varNodeN, second, first);
-        sparse_csr<T>::add_rows(checkNodeN, varNodeN, first, second);
-    }
-
-    template<typename T>
-    void sparse_csr<T>::swap_cols(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int first, const int second)
-    {
-        sparse_csr<T>::add_cols(checkNodeN, varNodeN, first, second);
-        sparse_csr<T>::add_cols(checkNodeN, varNodeN, second, first);
-        sparse_csr<T>::add_cols(checkNodeN, varNodeN, first, second);
-    }
-
-    template<typename T>
-    void sparse_csr<T>::add_rows(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int dest, const int src)
-    {
-        auto &row = checkNodeN[dest];
-        for (auto vn : checkNodeN[src]) // check vn index of src row
-        {
-            auto it = std::find(row.begin(), row.end(), vn); // dest already contains current vn index?
-            if (it == row.end()) // gf2 addition
-            {
-                row.push_front(vn); // add var index to row
-                varNodeN[vn].push_front(dest); // add row index to var
-            }
-            else // same index means removal
-            {
-                row.remove(vn); 
-                varNodeN[vn].remove(dest);
-            }
-        }
-    }
-
-    template<typename T>
-    void sparse_csr<T>::add_cols(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int dest, const int src)
+    template <typename T>
+    void sparse_csr<T>::save(binary_writer &out) const
     {
-        auto &col = varNodeN[dest];
-        for (auto cn : varNodeN[src]) // check cn index of src col
-        {
-            auto it = std::find(col.begin(), col.end(), cn); // dest already contains current cn index?
-            if (it == col.end()) // gf2 addition
-            {
-                col.push_front(cn); // add cn index to col
-                checkNodeN[cn].push_front(dest); // add col index to cn
-            }
-            else // same index means removal
-            {
-                col.remove(cn); 
-                checkNodeN[cn].remove(dest);
-            }
-        }
+        out.put(numCols);
+        out.put(numRows);
+        out.put(nonZeroVals);
+        out.put(colN);
+        out.put(rowN);
     }
 
-    template<typename T>
-    void sparse_csr<T>::zero_row(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int m)
+    template <typename T>
+    void sparse_csr<T>::load(binary_reader &in)
     {
-        for (auto vn : checkNodeN[m]) // from selected row, for each vn index, remove m from vn
-        {
-            varNodeN[vn].remove(m);
-        }
-        checkNodeN[m].clear();
+        in.get(numCols);
+        in.get(numRows);
+        in.get(nonZeroVals);
+        in.get(colN);
+        in.get(rowN);
     }
 
+    /**
+     * @brief Calculate rank over gf(2), non-zero entries are taken as one.
+     * 
+     * @tparam T finite field gf(2)
+     * @return int Rank
+     */
     template<typename T>
-    void sparse_csr<T>::zero_col(std::vector<std::forward_list<int>> &checkNodeN, std::vector<std::forward_list<int>> &varNodeN, const int n)
+    int sparse_csr<T>::rank() const
     {
-        for (auto cn : varNodeN[n]) // from selected col, for each cn index, remove n from cn
-        {
-            checkNodeN[cn].remove(n);
-        }
-        varNodeN[n].clear();
+        return gf2_rank(rowN, numCols);
     }
 } // namespace ldpc
@@ -0,0 +1,185 @@
+#include "trapping_sets.h"
+#include "cycles.h"
+
+#include <set>
+#include <tuple>
+
+namespace ldpc
+{
+    namespace
+    {
+        /**
+         * @brief Depth-first growth of elementary trapping sets of one thread.
+         */
+        class trapping_search
+        {
+        public:
+            trapping_search(const ldpc_code &code, const std::vector<vec_int> &checkVars, const trapping_param &param, std::set<vec_int> &visited)
+                : mVarN(code.var_neighbor()),
+                  mCheckVars(checkVars),
+                  mParam(param),
+                  mVisited(visited),
+                  mDegree(code.mc(), 0)
+            {
+            }
+
+            void grow_from(const vec_int &seed)
+            {
+                // the seed itself must be elementary and within maxA
+                if (seed.size() > mParam.maxA)
+                    return;
+
+                int b = 0;
+                mSet.clear();
+                for (auto v : seed)
+                {
+                    if (!fits(v))
+                        break;
+                    b = add(v, b);
+                    mSet.push_back(v);
+                }
+
+                if (mSet.size() == seed.size())
+                    grow(b);
+                for (auto v : mSet)
+                    remove(v);
+            }
+
+            const std::vector<trapping_set> &sets() const { return mSets; }
+
+        private:
+            void grow(const int b)
+            {
+                auto sorted = mSet;
+                std::sort(sorted.begin(), sorted.end());
+                if (!mVisited.insert(sorted).second)
+                    return;
+
+                if (b <= static_cast<int>(mParam.maxB))
+                    mSets.push_back(trapping_set({static_cast<int>(sorted.size()), b, sorted}));
+
+                if (sorted.size() >= mParam.maxA)
+                    return;
+
+                // variables on an unsatisfied check of the set
+                vec_int candidates;
+                for (auto v : mSet)
+                {
+                    for (const auto &c : mVarN[v])
+                    {
+                        if (mDegree[c.nodeIndex] != 1)
+                            continue;
+                        for (auto u : mCheckVars[c.nodeIndex])
+                        {
+                            if (!std::binary_search(sorted.begin(), sorted.end(), u))
+                                candidates.push_back(u);
+                        }
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+                for (auto u : candidates)
+                {
+                    if (!fits(u))
+                        continue;
+
+                    const int nb = add(u, b);
+                    if (nb <= static_cast<int>(mParam.maxB + mParam.slack))
+                    {
+                        mSet.push_back(u);
+                        grow(nb);
+                        mSet.pop_back();
+                    }
+                    remove(u);
+                }
+            }
+
+            // no check of the set would reach degree 3
+            bool fits(const int v) const
+            {
+                for (const auto &c : mVarN[v])
+                {
+                    if (mDegree[c.nodeIndex] >= 2)
+                        return false;
+                }
+                return true;
+            }
+
+            // unsatisfied checks after adding v
+            int add(const int v, int b)
+            {
+                for (const auto &c : mVarN[v])
+                    b += (mDegree[c.nodeIndex]++ == 0) ? 1 : -1;
+                return b;
+            }
+
+            void remove(const int v)
+            {
+                for (const auto &c : mVarN[v])
+                    --mDegree[c.nodeIndex];
+            }
+
+            const std::vector<std::vector<node>> &mVarN;
+            const std::vector<vec_int> &mCheckVars;
+            const trapping_param &mParam;
+            std::set<vec_int> &mVisited;
+
+            // degree of each check in the current set
+            vec_int mDegree;
+            vec_int mSet;
+            std::vector<trapping_set> mSets;
+        };
+    } // namespace
+
+    std::vector<trapping_set> enumerate_trapping_sets(const ldpc_code &code, const trapping_param &param)
+    {
+        const auto seeds = find_cycles(code.var_neighbor(), code.check_neighbor(), param.cycleLength);
+
+        std::vector<vec_int> checkVars(code.mc());
+        for (int i = 0; i < code.mc(); ++i)
+        {
+            for (const auto &v : code.check_neighbor()[i])
+                checkVars[i].push_back(v.nodeIndex);
+        }
+
+        std::vector<trapping_set> sets;
+        #pragma omp parallel
+        {
+            // sets reached from several seeds of a thread are grown once,
+            // duplicates across threads are removed below
+            std::set<vec_int> visited;
+            trapping_search search(code, checkVars, param, visited);
+
+            #pragma omp for schedule(dynamic, 16)
+            for (u64 i = 0; i < seeds.size(); ++i)
+            {
+                search.grow_from(seeds[i]);
+            }
+
+            #pragma omp critical
+            sets.insert(sets.end(), search.sets().begin(), search.sets().end());
+        }
+
+        std::sort(sets.begin(), sets.end(), [](const trapping_set &x, const trapping_set &y) {
+            return std::tie(x.a, x.b, x.vars) < std::tie(y.a, y.b, y.vars);
+        });
+        sets.erase(std::unique(sets.begin(), sets.end(), [](const trapping_set &x, const trapping_set &y) { return x.vars == y.vars; }), sets.end());
+        return sets;
+    }
+
+    void write_trapping_sets(const std::string &filename, const std::vector<trapping_set> &sets)
+    {
+        std::ofstream out(filename);
+        if (!out.good())
+            throw std::runtime_error("write_trapping_sets: can not open file for writing");
+
+        for (const auto &s : sets)
+        {
+            out << s.a << " " << s.b;
+            for (auto v : s.vars)
+                out << " " << v;
+            out << "\n";
+        }
+    }
+} // namespace ldpc
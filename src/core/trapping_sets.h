@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ldpc.h"
+
+namespace ldpc
+{
+    struct
+    {
+        u32 maxA;        // most variable nodes of a set
+        u32 maxB;        // most unsatisfied checks of a reported set
+        u32 cycleLength; // longest seed cycle
+        u32 slack;       // unsatisfied checks beyond maxB allowed while growing
+    } typedef trapping_param;
+
+    /**
+     * @brief Elementary (a, b) trapping set, i.e. a variable nodes whose
+     * induced subgraph has only checks of degree 1 and 2, b of them of
+     * degree 1.
+     */
+    struct trapping_set
+    {
+        int a;
+        int b;
+        vec_int vars; // ascending
+    };
+
+    /**
+     * @brief Enumerate elementary trapping sets grown from short cycles.
+     *
+     * Every cycle of length up to cycleLength of the decoding graph is a
+     * seed. A set grows by one variable node adjacent to an unsatisfied
+     * check of the set, as long as it stays elementary and has at most
+     * maxB + slack unsatisfied checks. Seeds are grown in parallel, each
+     * set is reported once.
+     *
+     * @param code LDPC code, its decoding graph is searched
+     * @param param Search parameters
+     * @return std::vector<trapping_set> Sets with a <= maxA and b <= maxB, by ascending a, b
+     */
+    std::vector<trapping_set> enumerate_trapping_sets(const ldpc_code &code, const trapping_param &param);
+
+    /**
+     * @brief Write trapping sets, one "a b v_1 ... v_a" line per set.
+     *
+     * @throw runtime_error if the file can not be opened
+     * @param filename Output file
+     * @param sets Trapping sets
+     */
+    void write_trapping_sets(const std::string &filename, const std::vector<trapping_set> &sets);
+} // namespace ldpc
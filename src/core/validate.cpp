@@ -0,0 +1,185 @@
+#include "validate.h"
+
+namespace ldpc
+{
+    namespace
+    {
+        // rows of G packed per pass, i.e. words per column
+        constexpr int PRODUCT_BLOCK_WORDS = 16;
+
+        // neighbours agree with the entries, returns false on the first mismatch
+        bool consistent_neighbors(const sparse_csr<bits_t> &A)
+        {
+            const auto &edges = A.nz_entry();
+            const int nnz = edges.size();
+
+            u64 rowSum = 0;
+            for (int i = 0; i < A.num_rows(); ++i)
+            {
+                for (const auto &n : A.row_neighbor()[i])
+                {
+                    if (n.edgeIndex < 0 || n.edgeIndex >= nnz || edges[n.edgeIndex].rowIndex != i || edges[n.edgeIndex].colIndex != n.nodeIndex)
+                        return false;
+                }
+                rowSum += A.row_neighbor()[i].size();
+            }
+
+            u64 colSum = 0;
+            for (int j = 0; j < A.num_cols(); ++j)
+            {
+                for (const auto &n : A.col_neighbor()[j])
+                {
+                    if (n.edgeIndex < 0 || n.edgeIndex >= nnz || edges[n.edgeIndex].colIndex != j || edges[n.edgeIndex].rowIndex != n.nodeIndex)
+                        return false;
+                }
+                colSum += A.col_neighbor()[j].size();
+            }
+
+            return rowSum == static_cast<u64>(nnz) && colSum == static_cast<u64>(nnz);
+        }
+
+        // repeated column indices within the rows, stamped by row
+        u64 duplicate_entries(const sparse_csr<bits_t> &A)
+        {
+            u64 duplicates = 0;
+            vec_int stamp(A.num_cols(), -1);
+            for (int i = 0; i < A.num_rows(); ++i)
+            {
+                for (const auto &n : A.row_neighbor()[i])
+                {
+                    duplicates += (stamp[n.nodeIndex] == i);
+                    stamp[n.nodeIndex] = i;
+                }
+            }
+            return duplicates;
+        }
+    } // namespace
+
+    u64 product_weight(const sparse_csr<bits_t> &G, const sparse_csr<bits_t> &H)
+    {
+        if (G.num_cols() != H.num_cols())
+            throw std::runtime_error("product_weight: G and H differ in the number of columns");
+
+        const int n = H.num_cols();
+        const auto &gEdges = G.nz_entry();
+        const auto &hEdges = H.nz_entry();
+
+        u64 weight = 0;
+        vec_u64 cols;
+        for (int first = 0; first < G.num_rows(); first += 64 * PRODUCT_BLOCK_WORDS)
+        {
+            const int rows = std::min(64 * PRODUCT_BLOCK_WORDS, G.num_rows() - first);
+            const int words = (rows + 63) / 64;
+
+            // column j of the block as bits over its rows, repeated entries cancel
+            cols.assign(static_cast<u64>(n) * words, 0);
+            for (int r = 0; r < rows; ++r)
+            {
+                for (const auto &g : G.row_neighbor()[first + r])
+                {
+                    if (gEdges[g.edgeIndex].value != 0)
+                        cols[static_cast<u64>(g.nodeIndex) * words + r / 64] ^= u64(1) << (r % 64);
+                }
+            }
+
+            #pragma omp parallel reduction(+ : weight)
+            {
+                vec_u64 acc(words);
+                #pragma omp for schedule(dynamic, 64)
+                for (int i = 0; i < H.num_rows(); ++i)
+                {
+                    std::fill(acc.begin(), acc.end(), 0);
+                    for (const auto &h : H.row_neighbor()[i])
+                    {
+                        if (hEdges[h.edgeIndex].value == 0)
+                            continue;
+
+                        const u64 *col = cols.data() + static_cast<u64>(h.nodeIndex) * words;
+                        for (int w = 0; w < words; ++w)
+                            acc[w] ^= col[w];
+                    }
+
+                    for (auto a : acc)
+                        weight += __builtin_popcountll(a);
+                }
+            }
+        }
+        return weight;
+    }
+
+    validation_report validate_code(const sparse_csr<bits_t> &H, const sparse_csr<bits_t> &G, const vec_int &puncture, const vec_int &shorten)
+    {
+        validation_report r;
+        const int n = H.num_cols();
+
+        auto fail = [&r](const std::string &msg, const u64 count) {
+            r.errors.push_back(msg + " : " + std::to_string(count));
+        };
+
+        const bool hConsistent = consistent_neighbors(H);
+        if (!hConsistent)
+            r.errors.push_back("H : neighbours do not match the entries");
+
+        // bits punctured or shortened twice, or both
+        u64 outOfRange = 0, repeated = 0;
+        std::vector<u8> marked(n, 0);
+        for (const auto *indices : {&puncture, &shorten})
+        {
+            for (auto i : *indices)
+            {
+                if (i < 0 || i >= n)
+                    ++outOfRange;
+                else
+                    repeated += (marked[i]++ > 0);
+            }
+        }
+        if (outOfRange > 0)
+            fail("puncture/shorten indices out of range", outOfRange);
+        if (repeated > 0)
+            fail("puncture/shorten indices repeated", repeated);
+
+        if (!G.empty())
+        {
+            const bool gConsistent = consistent_neighbors(G);
+            if (!gConsistent)
+                r.errors.push_back("G : neighbours do not match the entries");
+            if (G.num_cols() != n)
+                fail("G : columns, expected " + std::to_string(n), G.num_cols());
+
+            // kc() rows at least, at most the dimension n - rank(H), e.g. G of ldpcgen --full-dimension
+            const int minRows = n - H.num_rows();
+            const int maxRows = hConsistent ? n - H.rank() : minRows;
+            if (G.num_rows() < minRows || G.num_rows() > maxRows)
+                fail("G : rows, expected " + std::to_string(minRows) + (maxRows > minRows ? " to " + std::to_string(maxRows) : ""), G.num_rows());
+
+            // the product needs the neighbours of both
+            if (hConsistent && gConsistent && G.num_cols() == n)
+            {
+                r.duplicateEdges += duplicate_entries(G);
+                r.productWeight = product_weight(G, H);
+                if (r.productWeight > 0)
+                    fail("G H^T : non-zero entries", r.productWeight);
+            }
+        }
+
+        if (hConsistent)
+            r.duplicateEdges += duplicate_entries(H);
+        if (r.duplicateEdges > 0)
+            fail("duplicate entries", r.duplicateEdges);
+
+        return r;
+    }
+
+    validation_report validate_code(const ldpc_code &code)
+    {
+        return validate_code(code.H(), code.G(), code.puncture(), code.shorten());
+    }
+
+    std::ostream &operator<<(std::ostream &os, const validation_report &r)
+    {
+        for (const auto &e : r.errors)
+            os << e << "\n";
+        os << (r.valid() ? "Code : valid" : "Code : invalid") << "\n";
+        return os;
+    }
+} // namespace ldpc
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ldpc.h"
+
+namespace ldpc
+{
+    /**
+     * @brief Result of validate_code(), one message per failed check.
+     */
+    struct validation_report
+    {
+        std::vector<std::string> errors; // empty if the code is valid
+        u64 duplicateEdges = 0;          // repeated entries of H and G, which cancel over GF(2)
+        u64 productWeight = 0;           // non-zero entries of G H^T
+
+        bool valid() const { return errors.empty(); }
+    };
+
+    /**
+     * @brief Number of non-zero entries of G H^T, zero iff every row of G
+     * is a codeword of H.
+     *
+     * The rows of G are taken in blocks of 1024. Each column of a block is
+     * packed into words over its rows, so a row of H yields one column of
+     * the product by XOR of the packed columns at its entries, i.e. the
+     * cost is nnz(H) words per 64 rows of G. The rows of H are processed
+     * in parallel.
+     *
+     * @throw runtime_error if the number of columns differs
+     * @param G Generator matrix
+     * @param H Parity-check matrix
+     * @return u64 Weight of G H^T
+     */
+    u64 product_weight(const sparse_csr<bits_t> &G, const sparse_csr<bits_t> &H);
+
+    /**
+     * @brief Check a code for consistency.
+     *
+     * The neighbours of H and G must match their entries, i.e. the row
+     * and column degrees sum to the number of entries and each neighbour
+     * points to an entry at its position. Entries must not repeat, the
+     * puncture and shorten indices must be distinct bits of the code,
+     * G must have kc() to n - rank(H) rows of length nc(), and G H^T must
+     * be zero.
+     *
+     * @param H Parity-check matrix
+     * @param G Generator matrix, empty to skip its checks
+     * @param puncture Punctured bit indices
+     * @param shorten Shortened bit indices
+     * @return validation_report Failed checks
+     */
+    validation_report validate_code(const sparse_csr<bits_t> &H, const sparse_csr<bits_t> &G, const vec_int &puncture, const vec_int &shorten);
+
+    // validate_code() of a compiled code
+    validation_report validate_code(const ldpc_code &code);
+
+    std::ostream &operator<<(std::ostream &os, const validation_report &r);
+} // namespace ldpc
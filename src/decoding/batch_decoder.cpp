@@ -0,0 +1,84 @@
+#include "batch_decoder.h"
+
+#include <queue>
+
+namespace ldpc
+{
+    ldpc_batch_decoder::ldpc_batch_decoder(const std::shared_ptr<ldpc_code> &code,
+                                           const decoder_param &decoderParam,
+                                           const u32 batchSize)
+        : mStepParam(decoderParam),
+          mMaxIterations(decoderParam.iterations)
+    {
+        if (batchSize == 0)
+            throw std::runtime_error("ldpc_batch_decoder(): empty batch");
+
+        // frames are advanced by single iterations and resumed from their state
+        mStepParam.iterations = 1;
+        mStepParam.earlyTerm = true;
+
+        // separate decoders, so no state is shared between the frames
+        mDecoder.reserve(batchSize);
+        for (u32 i = 0; i < batchSize; ++i)
+        {
+            mDecoder.emplace_back(code, mStepParam);
+        }
+    }
+
+    const batch_report &ldpc_batch_decoder::decode(const double timeBudget, const u64 iterationBudget)
+    {
+        auto timeStart = std::chrono::steady_clock::now();
+        auto elapsed = [&timeStart]() {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - timeStart).count();
+        };
+        auto exhausted = [&]() {
+            return (timeBudget > 0 && elapsed() >= timeBudget) ||
+                   (iterationBudget > 0 && mReport.totalIterations >= iterationBudget);
+        };
+
+        mReport.iterations = vec_int(mDecoder.size(), 0);
+        mReport.converged = 0;
+        mReport.misses = 0;
+        mReport.totalIterations = 0;
+
+        // unsatisfied checks of the undecided frames, the one closest to converging on top
+        std::priority_queue<std::pair<u64, u32>, std::vector<std::pair<u64, u32>>, std::greater<std::pair<u64, u32>>> active;
+
+        auto step = [&](const u32 f, const bool first) {
+            if (first)
+                mDecoder[f].decode();
+            else
+                mDecoder[f].resume();
+
+            ++mReport.iterations[f];
+            ++mReport.totalIterations;
+
+            auto w = mDecoder[f].syndrome_weight();
+            if (w == 0)
+                ++mReport.converged;
+            else if (static_cast<u32>(mReport.iterations[f]) < mMaxIterations)
+                active.push(std::make_pair(w, f));
+        };
+
+        // a first iteration for every frame
+        u32 started = 0;
+        for (; started < mDecoder.size() && !exhausted(); ++started)
+        {
+            step(started, true);
+        }
+
+        // then the frames closest to converging
+        while (!active.empty() && !exhausted())
+        {
+            auto f = active.top().second;
+            active.pop();
+            step(f, false);
+        }
+
+        // frames not started have no valid estimate
+        mReport.misses = active.size() + (mDecoder.size() - started);
+        mReport.time = elapsed();
+
+        return mReport;
+    }
+} // namespace ldpc
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "decoder.h"
+
+namespace ldpc
+{
+    // Outcome of a deadline-bounded batch decoding
+    struct batch_report
+    {
+        vec_int iterations; // iterations used per frame
+        u32 converged;      // frames satisfying all checks
+        u32 misses;         // frames still decoding when the budget ran out
+        u64 totalIterations;
+        double time;        // elapsed time in microseconds
+    };
+
+    /**
+     * @brief Decodes a batch of frames under a common time or iteration
+     * budget.
+     *
+     * Each frame has its own decoder state and is advanced one iteration
+     * at a time. After a first iteration of every frame, the remaining
+     * budget goes to the frame with the fewest unsatisfied checks, i.e.
+     * the one closest to converging. The iteration limit of decoder_param
+     * still applies to each frame.
+     */
+    class ldpc_batch_decoder
+    {
+    public:
+        ldpc_batch_decoder() = default;
+        ldpc_batch_decoder(const std::shared_ptr<ldpc_code> &code,
+                           const decoder_param &decoderParam,
+                           const u32 batchSize);
+
+        /**
+         * @brief Decode all frames of the batch within the budget.
+         *
+         * @param timeBudget Time budget of the batch in microseconds, 0 for none
+         * @param iterationBudget Iterations over all frames of the batch, 0 for none
+         * @return const batch_report& Deadline misses and iterations used
+         */
+        const batch_report &decode(const double timeBudget, const u64 iterationBudget);
+
+        // Set the input LLR of a frame
+        void set_llr_in(const u32 frame, const vec_double_t &in) { mDecoder[frame].set_llr_in(in); }
+
+        // The estimated codeword of a frame
+        const vec_bits_t &estimate(const u32 frame) const { return mDecoder[frame].estimate(); }
+
+        // Output LLR of a frame
+        const vec_double_t &llr_out(const u32 frame) const { return mDecoder[frame].llr_out(); }
+
+        // Report of the last decoding
+        const batch_report &report() const { return mReport; }
+
+        u32 batch_size() const { return mDecoder.size(); }
+
+    private:
+        // iterations of a frame in a single step
+        decoder_param mStepParam;
+        u32 mMaxIterations;
+
+        std::vector<ldpc_decoder> mDecoder;
+        batch_report mReport;
+    };
+} // namespace ldpc
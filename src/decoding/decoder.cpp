@@ -2,45 +2,337 @@
 
 namespace ldpc
 {
+    std::vector<std::string> cascade_stages(const std::string &type)
+    {
+        std::vector<std::string> stages;
+        std::istringstream types(type);
+        for (std::string t; std::getline(types, t, ',');)
+        {
+            stages.push_back(t);
+        }
+
+        // an empty type decodes with BP
+        if (stages.empty())
+        {
+            stages.push_back(std::string("BP"));
+        }
+
+        return stages;
+    }
+
     ldpc_decoder::ldpc_decoder(const std::shared_ptr<ldpc_code> &code,
                                const decoder_param &decoderParam)
-        : ldpc_decoder_base<double>(code, decoderParam)
+        : ldpc_decoder_base<double>(code, decoderParam),
+          mStage(0),
+          mWeighted(false),
+          mOffset(0.0),
+          mUnsat(code->nc())
     {
+        set_param(decoderParam);
+    }
+
+    void ldpc_decoder::set_param(const decoder_param &param)
+    {
+        ldpc_decoder_base<double>::set_param(param);
+
+        mStages = cascade_stages(mDecoderParam.type);
+        mStage = 0;
+
+        if (std::find(mStages.begin(), mStages.end(), std::string("BP_WMS")) != mStages.end())
+        {
+            if (mDecoderParam.weightFile == nullptr || *mDecoderParam.weightFile == 0)
+            {
+                throw std::runtime_error("weighted min-sum requires a weight file");
+            }
+
+            // weights are only read again if the file changes
+            if (!mWeights || mWeightFile != mDecoderParam.weightFile)
+            {
+                mWeights = std::make_shared<cn_weights>(mDecoderParam.weightFile, mLdpcCode);
+                mWeightFile = mDecoderParam.weightFile;
+            }
+        }
+        else
+        {
+            mWeights.reset();
+        }
+
+        if (std::find(mStages.begin(), mStages.end(), std::string("LUT")) != mStages.end())
+        {
+            if (mStages.size() > 1)
+            {
+                throw std::runtime_error("lookup-table decoding can not be cascaded");
+            }
+
+            if (mDecoderParam.tableFile == nullptr || *mDecoderParam.tableFile == 0)
+            {
+                throw std::runtime_error("lookup-table decoding requires a table file");
+            }
+
+            if (!mLut || mTableFile != mDecoderParam.tableFile)
+            {
+                mLut = std::make_shared<ldpc_decoder_lut>(mLdpcCode, mDecoderParam.tableFile);
+                mTableFile = mDecoderParam.tableFile;
+            }
+        }
+        else
+        {
+            mLut.reset();
+        }
+    }
+
+    void ldpc_decoder::cn_update(const std::vector<node> &cn)
+    {
+        auto cw = cn.size();
+
+        // J. Chen et al. “Reduced-Complexity Decoding of LDPC Codes”
+        mExMsgF[0] = mLv2c[cn[0].edgeIndex];
+        mExMsgB[cw - 1] = mLv2c[cn[cw - 1].edgeIndex];
+        for (u64 j = 1; j < cw; ++j)
+        {
+            mExMsgF[j] = mCNApprox(mExMsgF[j - 1], mLv2c[cn[j].edgeIndex]);
+            mExMsgB[cw - 1 - j] = mCNApprox(mExMsgB[cw - j], mLv2c[cn[cw - j - 1].edgeIndex]);
+        }
+
+        mLc2v[cn[0].edgeIndex] = mExMsgB[1];
+        mLc2v[cn[cw - 1].edgeIndex] = mExMsgF[cw - 2];
+        for (u64 j = 1; j < cw - 1; ++j)
+        {
+            mLc2v[cn[j].edgeIndex] = mCNApprox(mExMsgF[j - 1], mExMsgB[j + 1]);
+        }
+    }
+
+    void ldpc_decoder::cn_post(const u32 iter, const int i)
+    {
+        auto &cn = (*mCheckN)[i];
+
+        if (mWeighted)
+        {
+            mWeights->apply(iter, i, cn, mLc2v);
+        }
+        else if (mOffset > 0)
+        {
+            for (const auto &hj : cn)
+            {
+                auto &msg = mLc2v[hj.edgeIndex];
+                msg = sign(msg) * std::max(std::abs(msg) - mOffset, 0.0);
+            }
+        }
     }
 
     int ldpc_decoder::decode()
+    {
+        // weights and tables of the unedited code are read again from the
+        // stored paths, the ones of the parameters may no longer exist
+        if (sync_code())
+        {
+            if (mWeights)
+            {
+                mWeights = std::make_shared<cn_weights>(mWeightFile, mLdpcCode);
+            }
+            if (mLut)
+            {
+                mLut = std::make_shared<ldpc_decoder_lut>(mLdpcCode, mTableFile);
+            }
+        }
+
+        if (mLut)
+        {
+            // the CRC replaces the syndrome test, a frame it accepts is re-encoded
+            bool reencoded = false;
+            std::function<bool()> crcTermination;
+            if (mCRC)
+            {
+                crcTermination = [this, &reencoded]() {
+                    mCO = mLut->estimate();
+                    mLLROut = mLut->llr_out();
+                    reencoded = early_termination();
+                    return reencoded;
+                };
+            }
+
+            auto I = mLut->decode(mLLRIn, mDecoderParam, crcTermination);
+            if (!reencoded)
+            {
+                mCO = mLut->estimate();
+                mLLROut = mLut->llr_out();
+            }
+            return I;
+        }
+
+        // a new frame starts on the reduced graph
+        mCheckN = &mLdpcCode->check_neighbor();
+        mVarN = &mLdpcCode->var_neighbor();
+
+        int I = 0;
+        for (mStage = 0; mStage < mStages.size(); ++mStage)
+        {
+            const auto &type = mStages[mStage];
+
+            if (type == std::string("BF"))
+            {
+                I += decode_bf();
+            }
+            else
+            {
+                set_stage(type);
+
+                // only soft-decision stages leave messages to resume from
+                bool warm = mDecoderParam.warmStart && mStage > 0 && mStages[mStage - 1] != std::string("BF");
+
+                I += (mDecoderParam.blockIterations > 0) ? decode_blocked(warm) : decode_flooding(warm);
+            }
+
+            // escalate to the next stage only on failure
+            if (mStage + 1 == mStages.size() || early_termination())
+            {
+                break;
+            }
+        }
+
+        return I;
+    }
+
+    void ldpc_decoder::set_stage(const std::string &type)
+    {
+        mCNApprox = ldpc::jacobian;
+        if (type == std::string("BP_MS") || type == std::string("BP_WMS") || type == std::string("BP_OMS"))
+        {
+            mCNApprox = ldpc::minsum;
+        }
+        mWeighted = (type == std::string("BP_WMS"));
+        mOffset = (type == std::string("BP_OMS")) ? mDecoderParam.msOffset : 0.0;
+    }
+
+    void ldpc_decoder::combine_llr(const vec_double_t &llr)
+    {
+        // after an edit of the code only the channel adds up, see resume()
+        if (mRevision != mLdpcCode->revision())
+        {
+            for (int i = 0; i < mLdpcCode->nc(); ++i)
+            {
+                mLLRIn[i] += llr[i];
+            }
+            return;
+        }
+
+        auto &edges = mLdpcCode->H().nz_entry();
+
+        for (auto e : mLdpcCode->pruned_edges())
+        {
+            if (llr[edges[e].colIndex] != 0.0)
+            {
+                use_full_graph();
+                break;
+            }
+        }
+
+        // the new LLR adds to the channel, APP and all VN messages of a bit
+        for (int i = 0; i < mLdpcCode->nc(); ++i)
+        {
+            if (llr[i] == 0.0)
+            {
+                continue;
+            }
+
+            mLLRIn[i] += llr[i];
+            mLLROut[i] += llr[i];
+            for (const auto &hj : (*mVarN)[i])
+            {
+                mLv2c[hj.edgeIndex] += llr[i];
+            }
+        }
+    }
+
+    int ldpc_decoder::resume()
+    {
+        // the messages of an edited code are stale, the frame starts over
+        if (mLut || mRevision != mLdpcCode->revision())
+        {
+            return decode();
+        }
+
+        const auto &type = mStages[mStage];
+        if (type == std::string("BF"))
+        {
+            return decode_bf();
+        }
+
+        set_stage(type);
+        return (mDecoderParam.blockIterations > 0) ? decode_blocked(true) : decode_flooding(true);
+    }
+
+    void ldpc_decoder::use_full_graph()
+    {
+        if (full_graph())
+        {
+            return;
+        }
+
+        auto &edges = mLdpcCode->H().nz_entry();
+
+        // the removed check was the only one of a pruned bit
+        for (auto e : mLdpcCode->pruned_edges())
+        {
+            mLLROut[edges[e].colIndex] = mLLRIn[edges[e].colIndex];
+        }
+
+        std::vector<bool> inGraph(mLdpcCode->nnz(), false);
+        for (const auto &cn : mLdpcCode->check_neighbor())
+        {
+            for (const auto &hj : cn)
+            {
+                inGraph[hj.edgeIndex] = true;
+            }
+        }
+
+        for (int e = 0; e < mLdpcCode->nnz(); ++e)
+        {
+            if (!inGraph[e])
+            {
+                mLc2v[e] = 0.0;
+                mLv2c[e] = mLLROut[edges[e].colIndex];
+            }
+        }
+
+        mRemovedChecks.clear();
+        for (int i = 0; i < mLdpcCode->mc(); ++i)
+        {
+            if (mLdpcCode->check_neighbor()[i].empty())
+            {
+                mRemovedChecks.push_back(i);
+            }
+        }
+
+        mCheckN = &mLdpcCode->H().row_neighbor();
+        mVarN = &mLdpcCode->H().col_neighbor();
+    }
+
+    int ldpc_decoder::decode_flooding(const bool warm)
     {
         auto &edges = mLdpcCode->H().nz_entry();
 
         //initialize
-        for (int i = 0; i < mLdpcCode->nnz(); ++i)
+        if (!warm)
         {
-            mLv2c[i] = mLLRIn[edges[i].colIndex];
+            for (int i = 0; i < mLdpcCode->nnz(); ++i)
+            {
+                mLv2c[i] = mLLRIn[edges[i].colIndex];
+            }
         }
 
+        bool reencoded = false;
         unsigned I = 0;
         while (I < mDecoderParam.iterations)
         {
             // CN processing
             for (int i = 0; i < mLdpcCode->mc(); ++i)
             {
-                auto cw = mLdpcCode->H().row_neighbor()[i].size();
-                auto &cn = mLdpcCode->H().row_neighbor()[i];
-
-                // J. Chen et al. “Reduced-Complexity Decoding of LDPC Codes”
-                mExMsgF[0] = mLv2c[cn[0].edgeIndex];
-                mExMsgB[cw - 1] = mLv2c[cn[cw - 1].edgeIndex];
-                for (u64 j = 1; j < cw; ++j)
-                {
-                    mExMsgF[j] = mCNApprox(mExMsgF[j - 1], mLv2c[cn[j].edgeIndex]);
-                    mExMsgB[cw - 1 - j] = mCNApprox(mExMsgB[cw - j], mLv2c[cn[cw - j - 1].edgeIndex]);
-                }
-
-                mLc2v[cn[0].edgeIndex] = mExMsgB[1];
-                mLc2v[cn[cw - 1].edgeIndex] = mExMsgF[cw - 2];
-                for (u64 j = 1; j < cw - 1; ++j)
+                // skip checks removed from the decoding graph
+                if (!(*mCheckN)[i].empty())
                 {
-                    mLc2v[cn[j].edgeIndex] = mCNApprox(mExMsgF[j - 1], mExMsgB[j + 1]);
+                    cn_update((*mCheckN)[i]);
+                    cn_post(I, i);
                 }
             }
 
@@ -48,7 +340,7 @@ namespace ldpc
             for (int i = 0; i < mLdpcCode->nc(); ++i) // only transmitted bits
             {
                 mLLROut[i] = mLLRIn[i];
-                auto &vn = mLdpcCode->H().col_neighbor()[i]; //neighbours of VN
+                auto &vn = (*mVarN)[i]; //neighbours of VN
 
                 for (const auto &hi : vn)
                 {
@@ -65,8 +357,9 @@ namespace ldpc
 
             if (mDecoderParam.earlyTerm)
             {
-                if (is_codeword())
+                if (early_termination())
                 {
+                    reencoded = static_cast<bool>(mCRC);
                     break;
                 }
             }
@@ -74,9 +367,183 @@ namespace ldpc
             ++I;
         }
 
+        // the re-encoded codeword holds the pruned bits already
+        if (!reencoded)
+        {
+            recover_pruned();
+        }
+
         return I;
     }
 
+    int ldpc_decoder::decode_blocked(const bool warm)
+    {
+        // the APP LLR is kept in mLLROut and updated after each check,
+        // so the VN messages are formed on the fly from the edges of a layer
+        if (!warm)
+        {
+            for (int i = 0; i < mLdpcCode->nc(); ++i)
+            {
+                mLLROut[i] = mLLRIn[i];
+            }
+            std::fill(mLc2v.begin(), mLc2v.end(), 0.);
+        }
+
+        bool reencoded = false;
+        unsigned I = 0;
+        while (I < mDecoderParam.iterations)
+        {
+            for (u64 k = 0; k <= mLdpcCode->layers().size(); ++k)
+            {
+                // the removed checks form a last layer of the full graph
+                if (k == mLdpcCode->layers().size() && !full_graph())
+                {
+                    break;
+                }
+                const auto &layer = (k < mLdpcCode->layers().size()) ? mLdpcCode->layers()[k] : mRemovedChecks;
+
+                // several local updates while the layer resides in cache
+                for (unsigned l = 0; l < mDecoderParam.blockIterations; ++l)
+                {
+                    for (auto i : layer)
+                    {
+                        auto &cn = (*mCheckN)[i];
+
+                        for (const auto &hj : cn)
+                        {
+                            mLv2c[hj.edgeIndex] = mLLROut[hj.nodeIndex] - mLc2v[hj.edgeIndex];
+                        }
+
+                        cn_update(cn);
+                        cn_post(I, i);
+
+                        for (const auto &hj : cn)
+                        {
+                            mLLROut[hj.nodeIndex] = mLv2c[hj.edgeIndex] + mLc2v[hj.edgeIndex];
+                        }
+                    }
+                }
+            }
+
+            for (int i = 0; i < mLdpcCode->nc(); ++i)
+            {
+                mCO[i] = (mLLROut[i] <= 0);
+            }
+
+            if (mDecoderParam.earlyTerm)
+            {
+                if (early_termination())
+                {
+                    reencoded = static_cast<bool>(mCRC);
+                    break;
+                }
+            }
+
+            ++I;
+        }
+
+        // the re-encoded codeword holds the pruned bits already
+        if (!reencoded)
+        {
+            recover_pruned();
+        }
+
+        return I;
+    }
+
+    int ldpc_decoder::decode_bf()
+    {
+        for (int i = 0; i < mLdpcCode->nc(); ++i)
+        {
+            mCO[i] = (mLLRIn[i] <= 0);
+        }
+
+        unsigned I = 0;
+        while (I < mDecoderParam.iterations)
+        {
+            // count the unsatisfied checks of each bit
+            std::fill(mUnsat.begin(), mUnsat.end(), 0);
+            bool satisfied = true;
+            for (const auto &cn : *mCheckN)
+            {
+                bits_t s = 0;
+                for (const auto &hj : cn)
+                {
+                    s += mCO[hj.nodeIndex];
+                }
+
+                if (s != 0)
+                {
+                    satisfied = false;
+                    for (const auto &hj : cn)
+                    {
+                        ++mUnsat[hj.nodeIndex];
+                    }
+                }
+            }
+
+            // nothing left to flip
+            if (satisfied)
+            {
+                break;
+            }
+
+            auto maxUnsat = *std::max_element(mUnsat.begin(), mUnsat.end());
+            for (int i = 0; i < mLdpcCode->nc(); ++i)
+            {
+                if (mUnsat[i] == maxUnsat)
+                {
+                    mCO[i] += 1;
+                }
+            }
+
+            ++I;
+        }
+
+        // hard decisions with the channel reliability
+        for (int i = 0; i < mLdpcCode->nc(); ++i)
+        {
+            mLLROut[i] = (1 - 2 * mCO[i].value) * std::abs(mLLRIn[i]);
+        }
+
+        recover_pruned();
+
+        return I;
+    }
+
+    void ldpc_decoder::recover_pruned()
+    {
+        // all bits are part of the full graph
+        if (full_graph())
+        {
+            return;
+        }
+
+        auto &edges = mLdpcCode->H().nz_entry();
+
+        // the removed check only connects the punctured bit to the final
+        // estimates of its other bits
+        for (auto e : mLdpcCode->pruned_edges())
+        {
+            auto v = edges[e].colIndex;
+            auto &cn = mLdpcCode->H().row_neighbor()[edges[e].rowIndex];
+
+            bool first = true;
+            double msg = 0.0;
+            for (const auto &hj : cn)
+            {
+                if (hj.nodeIndex == v)
+                    continue;
+
+                msg = first ? mLLROut[hj.nodeIndex] : mCNApprox(msg, mLLROut[hj.nodeIndex]);
+                first = false;
+            }
+
+            mLLROut[v] = msg;
+            mCO[v] = (msg <= 0);
+        }
+    }
+
     ldpc_decoder_bec::ldpc_decoder_bec(const std::shared_ptr<ldpc_code> &code,
                                        const decoder_param &decoderParam)
         : ldpc_decoder_base<u8>(code, decoderParam)
@@ -90,6 +557,7 @@ namespace ldpc
 
     int ldpc_decoder_bec::decode(const vec_bits_t &channelInput)
     {
+        sync_code();
         auto &edges = mLdpcCode->H().nz_entry();
 
         //initialize
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../core/ldpc.h"
+#include "../core/crc.h"
+#include "weights.h"
+#include "lut_decoder.h"
+
+#include <limits>
 
 namespace ldpc
 {
@@ -19,6 +24,15 @@ namespace ldpc
         return sign(x) * sign(y) * std::min(std::abs(x), std::abs(y));
     }
 
+    /**
+     * @brief Split the decoding type into the stages of a cascade, e.g.
+     * "BF,BP_OMS,BP". A single type is a cascade of one stage.
+     *
+     * @param type Decoding type
+     * @return std::vector<std::string> Stages in order of escalation
+     */
+    std::vector<std::string> cascade_stages(const std::string &type);
+
     /**
     * @brief LDPC Decoder base class
     * 
@@ -31,11 +45,13 @@ namespace ldpc
         ldpc_decoder_base(const std::shared_ptr<ldpc_code> &code,
                           const decoder_param &decoderParam)
             : mLdpcCode(code),
+              mCheckN(&code->check_neighbor()), mVarN(&code->var_neighbor()),
               mCNApprox(ldpc::jacobian),
               mCO(code->nc()),
               mLv2c(code->nnz()), mLc2v(code->nnz()),
               mExMsgF(code->max_degree()), mExMsgB(code->max_degree()),
-              mLLRIn(code->nc()), mLLROut(code->nc())
+              mLLRIn(code->nc()), mLLROut(code->nc()),
+              mRevision(code->revision())
         {
             set_param(decoderParam);
         }
@@ -43,7 +59,7 @@ namespace ldpc
 
         virtual int decode() { return 0; }
 
-        // Verifies whether mCO is a codeword or not
+        // Verifies whether mCO is a codeword of the decoding graph or not
         bool is_codeword()
         {
             //calc syndrome
@@ -51,7 +67,7 @@ namespace ldpc
             for (int i = 0; i < mLdpcCode->mc(); i++)
             {
                 s = 0;
-                for (const auto &hj : mLdpcCode->H().row_neighbor()[i])
+                for (const auto &hj : (*mCheckN)[i])
                 {
                     s += mCO[hj.nodeIndex];
                 }
@@ -63,6 +79,57 @@ namespace ldpc
             return true;
         }
 
+        // Number of unsatisfied checks of mCO in the decoding graph
+        u64 syndrome_weight()
+        {
+            u64 w = 0;
+            for (const auto &cn : *mCheckN)
+            {
+                bits_t s = 0;
+                for (const auto &hj : cn)
+                {
+                    s += mCO[hj.nodeIndex];
+                }
+                w += s.value;
+            }
+            return w;
+        }
+
+        // Verifies the CRC over the information bits of mCO
+        bool is_crc_valid()
+        {
+            for (u64 i = 0; i < mInfo.size(); ++i)
+            {
+                mInfo[i] = mCO[mLdpcCode->info_pos()[i]];
+            }
+            return mCRC->check(mInfo, mInfoTx);
+        }
+
+        // Early termination test, the CRC if configured, otherwise the syndrome
+        bool early_termination()
+        {
+            if (mCRC)
+            {
+                if (!is_crc_valid())
+                {
+                    return false;
+                }
+
+                // the remaining bits may still be in error, re-encode
+                // the information bits to obtain a codeword, which the
+                // hard decisions of the output LLRs follow
+                mLdpcCode->encode(mInfo, mCO);
+                for (u64 i = 0; i < mCO.size(); ++i)
+                {
+                    const T magnitude = std::max(std::abs(mLLROut[i]), std::numeric_limits<T>::min());
+                    mLLROut[i] = mCO[i].value ? -magnitude : magnitude;
+                }
+                return true;
+            }
+
+            return is_codeword();
+        }
+
         // Set the input LLR
         void set_llr_in(const std::vector<T> &in) { mLLRIn = in; }
 
@@ -70,21 +137,60 @@ namespace ldpc
         const std::vector<T> &llr_out() const { return mLLROut; }
 
         // Set the decoder parameters & update the CN approximation operation
-        void set_param(const decoder_param &param)
+        virtual void set_param(const decoder_param &param)
         {
             mDecoderParam = param;
-            if (mDecoderParam.type == std::string("BP_MS"))
+            mCNApprox = ldpc::jacobian;
+            if (mDecoderParam.type == std::string("BP_MS") || mDecoderParam.type == std::string("BP_WMS") || mDecoderParam.type == std::string("BP_OMS"))
             {
                 mCNApprox = ldpc::minsum;
             }
+
+            mCRC.reset();
+            if (mDecoderParam.crcPoly != 0)
+            {
+                if (mLdpcCode->info_pos().empty())
+                {
+                    throw std::runtime_error("CRC termination requires a systematic generator matrix");
+                }
+                mCRC = std::make_shared<crc>(mDecoderParam.crcPoly);
+                mInfo = vec_bits_t(mLdpcCode->kc());
+                mInfoTx = mLdpcCode->info_tx();
+            }
         }
 
         // The current estimated codeword
         const vec_bits_t &estimate() const { return mCO; }
 
     protected:
+        // Follow edits of the code, the messages are resized to its edges,
+        // returns true if the code was edited since the last call
+        bool sync_code()
+        {
+            if (mRevision == mLdpcCode->revision())
+            {
+                return false;
+            }
+
+            mRevision = mLdpcCode->revision();
+            mLv2c.resize(mLdpcCode->nnz());
+            mLc2v.resize(mLdpcCode->nnz());
+            mExMsgF.resize(mLdpcCode->max_degree());
+            mExMsgB.resize(mLdpcCode->max_degree());
+            if (mCRC)
+            {
+                mInfoTx = mLdpcCode->info_tx();
+            }
+            return true;
+        }
+
         std::shared_ptr<ldpc_code> mLdpcCode;
 
+        // decoding graph, the reduced graph of the code unless the
+        // bits removed from it are received later on
+        const std::vector<std::vector<node>> *mCheckN;
+        const std::vector<std::vector<node>> *mVarN;
+
         decoder_param mDecoderParam;
 
         // CN approximation operation
@@ -93,6 +199,11 @@ namespace ldpc
         // Estimated codeword
         vec_bits_t mCO;
 
+        // CRC over the transmitted information bits and their current estimate
+        std::shared_ptr<crc> mCRC;
+        vec_bits_t mInfo;
+        vec_int mInfoTx;
+
         // auxillary vectors for efficient CN update
         std::vector<T> mLv2c;
         std::vector<T> mLc2v;
@@ -102,11 +213,18 @@ namespace ldpc
 
         std::vector<T> mLLRIn;
         std::vector<T> mLLROut;
+
+        // revision of the code the messages are sized for
+        u64 mRevision = 0;
     };
 
     /**
      * @brief Standard LDPC BP decoder
-     * 
+     *
+     * The decoding type may list several decoders separated by commas,
+     * e.g. "BF,BP_OMS,BP". The frame is decoded by the first stage and
+     * escalates to the next one only if the estimate fails the syndrome
+     * (or CRC) check.
      */
     class ldpc_decoder : public ldpc_decoder_base<double>
     {
@@ -121,6 +239,83 @@ namespace ldpc
         virtual ~ldpc_decoder() = default;
 
         int decode() override;
+
+        // Set the decoder parameters & load the CN weights or the lookup tables
+        void set_param(const decoder_param &param) override;
+
+        // Stage of the cascade that produced the last estimate
+        u32 stage() const { return mStage; }
+
+        // Decoders of the cascade in order of escalation
+        const std::vector<std::string> &stages() const { return mStages; }
+
+        /**
+         * @brief Combine the LLRs of a further transmission, e.g. incremental
+         * redundancy on previously punctured bits, with the channel LLR and
+         * the message state of the last decoding.
+         *
+         * @param llr LLR of the transmission, zero for bits not received
+         */
+        void combine_llr(const vec_double_t &llr);
+
+        /**
+         * @brief Resume decoding from the message state of the last decoding
+         * with the stage that produced its estimate. After an edit of the
+         * code the messages are stale and the frame is decoded anew.
+         *
+         * @return int Number of iterations
+         */
+        int resume();
+
+    protected:
+        // Select the CN approximation and post-processing of a decoding stage
+        void set_stage(const std::string &type);
+
+        // Decode on the full graph of H once bits removed from the reduced
+        // graph are received, the messages of the new edges start cold
+        void use_full_graph();
+        bool full_graph() const { return mCheckN == &mLdpcCode->H().row_neighbor(); }
+
+        // CN update of a single check, from mLv2c to mLc2v
+        void cn_update(const std::vector<node> &cn);
+
+        // Weights or offset of the current stage applied to the messages of check i
+        void cn_post(const u32 iter, const int i);
+
+        // Flooding schedule, a warm start keeps the VN messages of the previous stage
+        int decode_flooding(const bool warm);
+
+        // Layered decoding over the cache-sized layers of the decoding graph,
+        // a warm start keeps the APP and CN messages of the previous stage
+        int decode_blocked(const bool warm);
+
+        // Hard-decision bit flipping of the bits with most unsatisfied checks
+        int decode_bf();
+
+        // Recover the punctured degree-1 bits removed from the decoding graph
+        void recover_pruned();
+
+        // CN weights of weighted min-sum and the file they were read from
+        std::shared_ptr<cn_weights> mWeights;
+        std::string mWeightFile;
+
+        // lookup-table decoder and the file its tables were read from
+        std::shared_ptr<ldpc_decoder_lut> mLut;
+        std::string mTableFile;
+
+        // cascade of decoders and the stage of the last estimate
+        std::vector<std::string> mStages;
+        u32 mStage;
+
+        // post-processing of the CN messages of the current stage
+        bool mWeighted;
+        double mOffset;
+
+        // unsatisfied checks per bit for bit flipping
+        vec_int mUnsat;
+
+        // checks removed from the reduced graph, an extra layer on the full graph
+        vec_int mRemovedChecks;
     };
 
     /**
@@ -0,0 +1,234 @@
+#include "lut_decoder.h"
+
+namespace ldpc
+{
+    ldpc_decoder_lut::ldpc_decoder_lut(const std::shared_ptr<ldpc_code> &code, const std::string &tableFile)
+        : mLdpcCode(code),
+          mBits(0),
+          mQ(0),
+          mLv2c((code->nnz() + 1) / 2),
+          mLc2v((code->nnz() + 1) / 2),
+          mChannel(code->nc()),
+          mExMsgF(code->max_degree()),
+          mLLROut(code->nc()),
+          mCO(code->nc())
+    {
+        std::ifstream infile(tableFile);
+        std::string line;
+
+        if (!infile.good())
+            throw std::runtime_error("can not open table file for reading");
+
+        while (getline(infile, line))
+        {
+            std::istringstream record(line);
+            std::string key;
+            if (!(record >> key) || key[0] == '#')
+                continue;
+
+            if (key == "bits")
+            {
+                record >> mBits;
+                if (mBits < 1 || mBits > 4)
+                    throw std::runtime_error("table file: message resolution must be 1 to 4 bits");
+                mQ = 1 << mBits;
+                continue;
+            }
+
+            if (mQ == 0)
+                throw std::runtime_error("table file: bits must be given first");
+
+            if (key == "quantizer" || key == "llr")
+            {
+                vec_double_t values;
+                double v;
+                while (record >> v)
+                    values.push_back(v);
+
+                if (key == "quantizer")
+                {
+                    if (static_cast<int>(values.size()) != mQ - 1 || !std::is_sorted(values.begin(), values.end()))
+                        throw std::runtime_error("table file: quantizer needs Q-1 ascending thresholds");
+                    mThresholds = values;
+                }
+                else
+                {
+                    if (static_cast<int>(values.size()) != mQ)
+                        throw std::runtime_error("table file: llr needs Q values");
+                    mRecon = values;
+                }
+            }
+            else if (key == "cn" || key == "vn")
+            {
+                std::vector<u8> table;
+                int v;
+                while (record >> v)
+                {
+                    if (v < 0 || v >= mQ)
+                        throw std::runtime_error("table file: table entry out of range");
+                    table.push_back(v);
+                }
+
+                if (static_cast<int>(table.size()) != mQ * mQ)
+                    throw std::runtime_error("table file: tables need Q*Q entries");
+
+                (key == "cn" ? mCNTable : mVNTable).push_back(table);
+            }
+            else
+            {
+                throw std::runtime_error("table file: unknown keyword " + key);
+            }
+        }
+
+        if (mThresholds.empty() || mCNTable.empty() || mVNTable.empty())
+            throw std::runtime_error("table file: quantizer, cn and vn tables are required");
+
+        // symbols centered around zero if no reconstruction is given
+        if (mRecon.empty())
+        {
+            for (int s = 0; s < mQ; ++s)
+                mRecon.push_back(s - (mQ - 1) / 2.);
+        }
+    }
+
+    bool ldpc_decoder_lut::is_codeword() const
+    {
+        for (const auto &cn : mLdpcCode->check_neighbor())
+        {
+            bits_t s = 0;
+            for (const auto &hj : cn)
+            {
+                s += mCO[hj.nodeIndex];
+            }
+            if (s != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int ldpc_decoder_lut::decode(const vec_double_t &llrIn, const decoder_param &param, const std::function<bool()> &terminate)
+    {
+        const u8 half = mQ / 2;
+
+        // quantize the channel
+        for (int i = 0; i < mLdpcCode->nc(); ++i)
+        {
+            mChannel[i] = std::upper_bound(mThresholds.begin(), mThresholds.end(), llrIn[i]) - mThresholds.begin();
+        }
+
+        //initialize
+        auto &edges = mLdpcCode->H().nz_entry();
+        for (int i = 0; i < mLdpcCode->nnz(); ++i)
+        {
+            set(mLv2c, i, mChannel[edges[i].colIndex]);
+        }
+
+        u32 I = 0;
+        while (I < param.iterations)
+        {
+            // CN update
+            for (const auto &cn : mLdpcCode->check_neighbor())
+            {
+                auto cw = cn.size();
+                if (cw < 2)
+                    continue;
+
+                // each extrinsic message is one left-to-right chain over the
+                // other edges, the tables need not be symmetric or associative
+                mExMsgF[0] = get(mLv2c, cn[0].edgeIndex);
+                for (u64 j = 1; j < cw; ++j)
+                {
+                    mExMsgF[j] = cn_table(I, mExMsgF[j - 1], get(mLv2c, cn[j].edgeIndex));
+                }
+
+                for (u64 j = 0; j < cw; ++j)
+                {
+                    u64 k = (j == 0) ? 2 : j + 1;
+                    u8 msg = (j == 0) ? get(mLv2c, cn[1].edgeIndex) : mExMsgF[j - 1];
+                    for (; k < cw; ++k)
+                    {
+                        msg = cn_table(I, msg, get(mLv2c, cn[k].edgeIndex));
+                    }
+                    set(mLc2v, cn[j].edgeIndex, msg);
+                }
+            }
+
+            // VN update, every chain starts at the channel symbol and adds
+            // the other c2v messages one by one, as the tables are designed
+            for (int i = 0; i < mLdpcCode->nc(); ++i)
+            {
+                auto &vn = mLdpcCode->var_neighbor()[i];
+                auto vw = vn.size();
+
+                u8 app = mChannel[i];
+                if (vw > 0)
+                {
+                    mExMsgF[0] = vn_table(I, mChannel[i], get(mLc2v, vn[0].edgeIndex));
+                    for (u64 j = 1; j < vw; ++j)
+                    {
+                        mExMsgF[j] = vn_table(I, mExMsgF[j - 1], get(mLc2v, vn[j].edgeIndex));
+                    }
+
+                    for (u64 j = 0; j < vw; ++j)
+                    {
+                        u8 msg = (j == 0) ? mChannel[i] : mExMsgF[j - 1];
+                        for (u64 k = j + 1; k < vw; ++k)
+                        {
+                            msg = vn_table(I, msg, get(mLc2v, vn[k].edgeIndex));
+                        }
+                        set(mLv2c, vn[j].edgeIndex, msg);
+                    }
+
+                    app = mExMsgF[vw - 1];
+                }
+
+                mCO[i] = (app < half);
+                mLLROut[i] = mRecon[app];
+            }
+
+            if (param.earlyTerm)
+            {
+                // a caller's test, e.g. a CRC, ends the frame as it is
+                if (terminate)
+                {
+                    if (terminate())
+                    {
+                        return I;
+                    }
+                }
+                else if (is_codeword())
+                {
+                    break;
+                }
+            }
+
+            ++I;
+        }
+
+        // recover the punctured degree-1 bits from the checks removed from the graph
+        for (auto e : mLdpcCode->pruned_edges())
+        {
+            auto v = edges[e].colIndex;
+            bool first = true;
+            u8 msg = mChannel[v];
+            bits_t bit = 0;
+            for (const auto &hj : mLdpcCode->H().row_neighbor()[edges[e].rowIndex])
+            {
+                if (hj.nodeIndex == v)
+                    continue;
+
+                auto s = static_cast<u8>(std::upper_bound(mThresholds.begin(), mThresholds.end(), mLLROut[hj.nodeIndex]) - mThresholds.begin());
+                msg = first ? s : cn_table(I, msg, s);
+                bit += mCO[hj.nodeIndex];
+                first = false;
+            }
+
+            mCO[v] = bit;
+            mLLROut[v] = mRecon[msg];
+        }
+
+        return I;
+    }
+} // namespace ldpc
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../core/ldpc.h"
+
+#include <functional>
+
+namespace ldpc
+{
+    /**
+     * @brief Lookup-table message-passing decoder with 3-4 bit messages.
+     *
+     * Messages are symbols of an alphabet of size Q = 2^b, ordered by
+     * reliability, i.e. symbols below Q/2 decide for a one. CN and VN
+     * updates are two-input tables designed offline (e.g. information
+     * bottleneck decoders) and read from file. Messages are packed two
+     * per byte.
+     *
+     * The table file holds lines of a keyword followed by its values:
+     *   bits b              message resolution, b <= 4
+     *   quantizer t_0 ...   Q-1 ascending channel LLR thresholds
+     *   llr r_0 ...         Q output LLRs of the symbols (optional)
+     *   cn v_0 ...          Q*Q CN table, row-major in (a, b)
+     *   vn v_0 ...          Q*Q VN table, a is the partial combination
+     *                       including the channel symbol
+     * cn and vn lines may be repeated for each iteration, the last one
+     * is used for all later iterations. The tables are applied in a chain,
+     * one input at a time, so they need not be symmetric or associative.
+     */
+    class ldpc_decoder_lut
+    {
+    public:
+        ldpc_decoder_lut() = default;
+
+        /**
+         * @brief Construct a new ldpc decoder lut object.
+         *
+         * @throw runtime_error
+         * @param code LDPC code
+         * @param tableFile Table file
+         */
+        ldpc_decoder_lut(const std::shared_ptr<ldpc_code> &code, const std::string &tableFile);
+
+        /**
+         * @brief Quantize the channel LLRs and decode.
+         *
+         * @param llrIn Channel LLR
+         * @param param Decoder parameters
+         * @param terminate Early termination test after each iteration instead
+         *                  of the syndrome, the punctured degree-1 bits are then
+         *                  not recovered
+         * @return int Number of iterations
+         */
+        int decode(const vec_double_t &llrIn, const decoder_param &param, const std::function<bool()> &terminate = nullptr);
+
+        // The current estimated codeword
+        const vec_bits_t &estimate() const { return mCO; }
+
+        // Output LLR, i.e. the reconstruction values of the APP symbols
+        const vec_double_t &llr_out() const { return mLLROut; }
+
+        // Message resolution in bits
+        int bits() const { return mBits; }
+
+    private:
+        u8 cn_table(const u32 iter, const u8 a, const u8 b) const
+        {
+            return mCNTable[std::min<u64>(iter, mCNTable.size() - 1)][(a << mBits) | b];
+        }
+
+        u8 vn_table(const u32 iter, const u8 a, const u8 b) const
+        {
+            return mVNTable[std::min<u64>(iter, mVNTable.size() - 1)][(a << mBits) | b];
+        }
+
+        // packed message access, two messages per byte
+        static u8 get(const std::vector<u8> &msg, const int e)
+        {
+            return (msg[e >> 1] >> ((e & 1) << 2)) & 0xF;
+        }
+
+        static void set(std::vector<u8> &msg, const int e, const u8 v)
+        {
+            const int shift = (e & 1) << 2;
+            msg[e >> 1] = (msg[e >> 1] & ~(0xF << shift)) | (v << shift);
+        }
+
+        bool is_codeword() const;
+
+        std::shared_ptr<ldpc_code> mLdpcCode;
+
+        int mBits;
+        int mQ;
+        vec_double_t mThresholds;
+        vec_double_t mRecon;
+        std::vector<std::vector<u8>> mCNTable;
+        std::vector<std::vector<u8>> mVNTable;
+
+        // packed messages
+        std::vector<u8> mLv2c;
+        std::vector<u8> mLc2v;
+
+        std::vector<u8> mChannel;
+        // forward partials of a node, from which the extrinsic chains continue
+        std::vector<u8> mExMsgF;
+
+        vec_double_t mLLROut;
+        vec_bits_t mCO;
+    };
+} // namespace ldpc
@@ -0,0 +1,413 @@
+#pragma once
+
+#include "../core/functions.h"
+#include "../core/gf2m.h"
+
+#include <limits>
+
+namespace ldpc
+{
+    /**
+     * @brief Non-binary BP decoder for LDPC codes over GF(q), q = 2^M.
+     *
+     * The check of edge values h_j constrains sum h_j x_j = 0, so after
+     * permuting each message by its edge value the CN update is a
+     * convolution over the additive group of GF(q), i.e. over XOR:
+     *   "BP"  probability domain, the convolution is a product after a
+     *         Walsh-Hadamard transform, q log q per message
+     *   "EMS" extended min-sum, messages are costs (negative log-domain,
+     *         0 for the most likely symbol) and the elementary CN step
+     *         only combines the nm most reliable symbols of each input,
+     *         nm^2 per step. The default nm^2 ~ q log q matches the FFT.
+     * VN updates are done in the log domain for both.
+     *
+     * The channel input holds q log-likelihoods log P(y_v | x_v = a) per
+     * symbol v, stored as in[v * q + a].
+     *
+     * @tparam T Field, gf2m<M>
+     */
+    template <typename T>
+    class ldpc_decoder_nb
+    {
+    public:
+        static constexpr int q = T::q;
+
+        ldpc_decoder_nb() = default;
+
+        /**
+         * @brief Construct a new non-binary decoder.
+         *
+         * @param H Parity-check matrix over GF(q)
+         * @param decoderParam Decoder parameters, type "BP" or "EMS"
+         * @param nm Truncation of EMS messages, 0 for nm^2 ~ q log q
+         */
+        ldpc_decoder_nb(const std::shared_ptr<sparse_csr<T>> &H,
+                        const decoder_param &decoderParam,
+                        const int nm = 0);
+
+        int decode();
+
+        // Set the input symbol log-likelihoods, q per symbol
+        void set_llr_in(const vec_double_t &in) { mLLRIn = in; }
+
+        // The current estimated codeword
+        const std::vector<T> &estimate() const { return mCO; }
+
+        // Verifies whether mCO is a codeword
+        bool is_codeword() const;
+
+        // Set the decoder parameters
+        void set_param(const decoder_param &param);
+
+        // Truncation of the EMS messages
+        int nm() const { return mNm; }
+
+    private:
+        void vn_update(const int v);
+        void cn_update_fft(const std::vector<node> &cn);
+        void cn_update_ems(const std::vector<node> &cn);
+
+        // in-place Walsh-Hadamard transform of q values
+        static void wht(double *x);
+
+        // elementary EMS step c(a + b) = min(a(a) + b(b)) over the nm best symbols
+        void ems_combine(const double *a, const double *b, double *c);
+
+        // message permutation by an edge value, c(h x) = m(x) and back
+        void permute(const double *m, const T h, double *c) const;
+        void depermute(const double *c, const T h, double *m) const;
+
+        std::shared_ptr<sparse_csr<T>> mH;
+        decoder_param mDecoderParam;
+        bool mEMS;
+        int mNm;
+
+        // q values per edge, probabilities ("BP") or costs ("EMS") on the check side
+        vec_double_t mLv2c;
+        vec_double_t mLc2v;
+
+        // auxillary vectors, q values per position
+        vec_double_t mPerm;
+        vec_double_t mExMsgF;
+        vec_double_t mExMsgB;
+        vec_double_t mApp;
+        vec_int mIdxA;
+        vec_int mIdxB;
+
+        vec_double_t mLLRIn;
+        std::vector<T> mCO;
+    };
+
+    template <typename T>
+    ldpc_decoder_nb<T>::ldpc_decoder_nb(const std::shared_ptr<sparse_csr<T>> &H,
+                                        const decoder_param &decoderParam,
+                                        const int nm)
+        : mH(H),
+          mEMS(false),
+          mNm(nm),
+          mLv2c(H->nz_entry().size() * q),
+          mLc2v(H->nz_entry().size() * q),
+          mApp(q),
+          mIdxA(q), mIdxB(q),
+          mLLRIn(static_cast<u64>(H->num_cols()) * q),
+          mCO(H->num_cols(), T(0))
+    {
+        u64 maxDegree = 0;
+        for (const auto &cn : mH->row_neighbor())
+            maxDegree = std::max(maxDegree, cn.size());
+
+        mPerm = vec_double_t(maxDegree * q);
+        mExMsgF = vec_double_t(maxDegree * q);
+        mExMsgB = vec_double_t(maxDegree * q);
+
+        if (mNm <= 0)
+        {
+            mNm = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(q) * std::log2(q))));
+        }
+        mNm = std::min(mNm, q);
+
+        set_param(decoderParam);
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::set_param(const decoder_param &param)
+    {
+        mDecoderParam = param;
+        mEMS = (mDecoderParam.type == std::string("EMS"));
+    }
+
+    template <typename T>
+    bool ldpc_decoder_nb<T>::is_codeword() const
+    {
+        for (const auto &cn : mH->row_neighbor())
+        {
+            T s(0);
+            for (const auto &hj : cn)
+            {
+                s += mH->nz_entry()[hj.edgeIndex].value * mCO[hj.nodeIndex];
+            }
+            if (s != T(0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::wht(double *x)
+    {
+        for (int len = 1; len < q; len <<= 1)
+        {
+            for (int i = 0; i < q; i += 2 * len)
+            {
+                for (int j = i; j < i + len; ++j)
+                {
+                    auto a = x[j];
+                    auto b = x[j + len];
+                    x[j] = a + b;
+                    x[j + len] = a - b;
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::permute(const double *m, const T h, double *c) const
+    {
+        for (int a = 0; a < q; ++a)
+        {
+            c[(h * T(a)).value] = m[a];
+        }
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::depermute(const double *c, const T h, double *m) const
+    {
+        for (int a = 0; a < q; ++a)
+        {
+            m[a] = c[(h * T(a)).value];
+        }
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::ems_combine(const double *a, const double *b, double *c)
+    {
+        auto cmpA = [a](const int i, const int j) { return a[i] < a[j]; };
+        auto cmpB = [b](const int i, const int j) { return b[i] < b[j]; };
+        for (int i = 0; i < q; ++i)
+        {
+            mIdxA[i] = i;
+            mIdxB[i] = i;
+        }
+        std::partial_sort(mIdxA.begin(), mIdxA.begin() + mNm, mIdxA.end(), cmpA);
+        std::partial_sort(mIdxB.begin(), mIdxB.begin() + mNm, mIdxB.end(), cmpB);
+
+        std::fill(c, c + q, std::numeric_limits<double>::infinity());
+        for (int i = 0; i < mNm; ++i)
+        {
+            for (int j = 0; j < mNm; ++j)
+            {
+                auto &y = c[mIdxA[i] ^ mIdxB[j]];
+                y = std::min(y, a[mIdxA[i]] + b[mIdxB[j]]);
+            }
+        }
+
+        // symbols not reached are set to the least reliable computed one
+        double worst = 0.0;
+        for (int y = 0; y < q; ++y)
+        {
+            if (c[y] != std::numeric_limits<double>::infinity())
+                worst = std::max(worst, c[y]);
+        }
+        for (int y = 0; y < q; ++y)
+        {
+            if (c[y] == std::numeric_limits<double>::infinity())
+                c[y] = worst;
+        }
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::cn_update_fft(const std::vector<node> &cn)
+    {
+        auto cw = cn.size();
+        auto &edges = mH->nz_entry();
+
+        // permuted messages in the transform domain
+        for (u64 j = 0; j < cw; ++j)
+        {
+            permute(&mLv2c[cn[j].edgeIndex * q], edges[cn[j].edgeIndex].value, &mPerm[j * q]);
+            wht(&mPerm[j * q]);
+        }
+
+        // forward/backward products of all but one message
+        std::copy(&mPerm[0], &mPerm[0] + q, &mExMsgF[0]);
+        std::copy(&mPerm[(cw - 1) * q], &mPerm[(cw - 1) * q] + q, &mExMsgB[(cw - 1) * q]);
+        for (u64 j = 1; j < cw; ++j)
+        {
+            for (int a = 0; a < q; ++a)
+            {
+                mExMsgF[j * q + a] = mExMsgF[(j - 1) * q + a] * mPerm[j * q + a];
+                mExMsgB[(cw - 1 - j) * q + a] = mExMsgB[(cw - j) * q + a] * mPerm[(cw - 1 - j) * q + a];
+            }
+        }
+
+        for (u64 j = 0; j < cw; ++j)
+        {
+            for (int a = 0; a < q; ++a)
+            {
+                if (j == 0)
+                    mApp[a] = mExMsgB[q + a];
+                else if (j == cw - 1)
+                    mApp[a] = mExMsgF[(cw - 2) * q + a];
+                else
+                    mApp[a] = mExMsgF[(j - 1) * q + a] * mExMsgB[(j + 1) * q + a];
+            }
+
+            // the inverse transform is the transform scaled by 1/q, which
+            // cancels with the normalization
+            wht(&mApp[0]);
+            double sum = 0.0;
+            for (auto &p : mApp)
+            {
+                p = std::max(p, 0.0);
+                sum += p;
+            }
+            for (auto &p : mApp)
+            {
+                p = (sum > 0) ? p / sum : 1.0 / q;
+            }
+
+            depermute(&mApp[0], edges[cn[j].edgeIndex].value, &mLc2v[cn[j].edgeIndex * q]);
+        }
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::cn_update_ems(const std::vector<node> &cn)
+    {
+        auto cw = cn.size();
+        auto &edges = mH->nz_entry();
+
+        for (u64 j = 0; j < cw; ++j)
+        {
+            permute(&mLv2c[cn[j].edgeIndex * q], edges[cn[j].edgeIndex].value, &mPerm[j * q]);
+        }
+
+        std::copy(&mPerm[0], &mPerm[0] + q, &mExMsgF[0]);
+        std::copy(&mPerm[(cw - 1) * q], &mPerm[(cw - 1) * q] + q, &mExMsgB[(cw - 1) * q]);
+        for (u64 j = 1; j < cw; ++j)
+        {
+            ems_combine(&mExMsgF[(j - 1) * q], &mPerm[j * q], &mExMsgF[j * q]);
+            ems_combine(&mExMsgB[(cw - j) * q], &mPerm[(cw - 1 - j) * q], &mExMsgB[(cw - 1 - j) * q]);
+        }
+
+        for (u64 j = 0; j < cw; ++j)
+        {
+            if (j == 0)
+                std::copy(&mExMsgB[q], &mExMsgB[q] + q, &mApp[0]);
+            else if (j == cw - 1)
+                std::copy(&mExMsgF[(cw - 2) * q], &mExMsgF[(cw - 2) * q] + q, &mApp[0]);
+            else
+                ems_combine(&mExMsgF[(j - 1) * q], &mExMsgB[(j + 1) * q], &mApp[0]);
+
+            depermute(&mApp[0], edges[cn[j].edgeIndex].value, &mLc2v[cn[j].edgeIndex * q]);
+        }
+    }
+
+    template <typename T>
+    void ldpc_decoder_nb<T>::vn_update(const int v)
+    {
+        auto &vn = mH->col_neighbor()[v];
+
+        // APP log-likelihood
+        for (int a = 0; a < q; ++a)
+        {
+            double llr = mLLRIn[v * q + a];
+            for (const auto &hi : vn)
+            {
+                auto c2v = mLc2v[hi.edgeIndex * q + a];
+                llr += mEMS ? -c2v : std::log(std::max(c2v, 1e-300));
+            }
+            mApp[a] = llr;
+        }
+        mCO[v] = T(static_cast<int>(std::max_element(mApp.begin(), mApp.end()) - mApp.begin()));
+
+        // extrinsic messages, normalized to the most likely symbol
+        for (const auto &hi : vn)
+        {
+            auto msg = &mLv2c[hi.edgeIndex * q];
+            auto c2v = &mLc2v[hi.edgeIndex * q];
+            double maxLlr = -std::numeric_limits<double>::infinity();
+            for (int a = 0; a < q; ++a)
+            {
+                msg[a] = mApp[a] - (mEMS ? -c2v[a] : std::log(std::max(c2v[a], 1e-300)));
+                maxLlr = std::max(maxLlr, msg[a]);
+            }
+
+            double sum = 0.0;
+            for (int a = 0; a < q; ++a)
+            {
+                msg[a] = mEMS ? (maxLlr - msg[a]) : std::exp(msg[a] - maxLlr);
+                sum += msg[a];
+            }
+            if (!mEMS)
+            {
+                for (int a = 0; a < q; ++a)
+                    msg[a] /= sum;
+            }
+        }
+    }
+
+    template <typename T>
+    int ldpc_decoder_nb<T>::decode()
+    {
+        //initialize, no CN messages yet
+        std::fill(mLc2v.begin(), mLc2v.end(), mEMS ? 0.0 : 1.0);
+        for (int v = 0; v < mH->num_cols(); ++v)
+        {
+            vn_update(v);
+        }
+
+        unsigned I = 0;
+        while (I < mDecoderParam.iterations)
+        {
+            // CN processing
+            for (const auto &cn : mH->row_neighbor())
+            {
+                if (cn.size() < 2)
+                {
+                    // a single symbol of the check is zero
+                    for (const auto &hj : cn)
+                    {
+                        for (int a = 0; a < q; ++a)
+                            mLc2v[hj.edgeIndex * q + a] = mEMS ? ((a == 0) ? 0.0 : 1e30) : (a == 0);
+                    }
+                    continue;
+                }
+
+                if (mEMS)
+                    cn_update_ems(cn);
+                else
+                    cn_update_fft(cn);
+            }
+
+            // VN processing and app calc
+            for (int v = 0; v < mH->num_cols(); ++v)
+            {
+                vn_update(v);
+            }
+
+            if (mDecoderParam.earlyTerm)
+            {
+                if (is_codeword())
+                {
+                    break;
+                }
+            }
+
+            ++I;
+        }
+
+        return I;
+    }
+} // namespace ldpc
@@ -0,0 +1,145 @@
+#include "weights.h"
+
+namespace ldpc
+{
+    namespace
+    {
+        struct weight_entry
+        {
+            int iter; // -1 for all iterations
+            cn_weights::granularity kind;
+            int index; // degree, check or edge index
+            double value;
+        };
+    } // namespace
+
+    cn_weights::cn_weights(const std::string &filename, const std::shared_ptr<ldpc_code> &code)
+        : mLdpcCode(code)
+    {
+        std::ifstream infile(filename);
+        std::string line;
+
+        if (!infile.good())
+            throw std::runtime_error("can not open weight file for reading");
+
+        std::vector<weight_entry> entries;
+        int maxIter = 0;
+
+        while (getline(infile, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream record(line);
+            std::string it, ch, ed;
+            weight_entry entry;
+            if (!(record >> it >> ch >> ed >> entry.value))
+                throw std::runtime_error("invalid weight entry: " + line);
+
+            entry.iter = (it == "*") ? -1 : std::stoi(it);
+            maxIter = std::max(maxIter, entry.iter);
+
+            if (ed != "*")
+            {
+                entry.kind = EDGE;
+                entry.index = std::stoi(ed);
+                if (entry.index < 0 || entry.index >= code->nnz())
+                    throw std::runtime_error("weight entry edge out of range: " + line);
+                if (ch != "*" && ch[0] != 'd' && std::stoi(ch) != code->H().nz_entry()[entry.index].rowIndex)
+                    throw std::runtime_error("weight entry edge not connected to check: " + line);
+            }
+            else if (ch == "*")
+            {
+                entry.kind = SCALAR;
+                entry.index = -1;
+            }
+            else if (ch[0] == 'd')
+            {
+                entry.kind = DEGREE;
+                entry.index = std::stoi(ch.substr(1));
+                if (entry.index < 0 || entry.index > code->max_degree())
+                    throw std::runtime_error("weight entry degree out of range: " + line);
+            }
+            else
+            {
+                entry.kind = CHECK;
+                entry.index = std::stoi(ch);
+                if (entry.index < 0 || entry.index >= code->mc())
+                    throw std::runtime_error("weight entry check out of range: " + line);
+            }
+
+            entries.push_back(entry);
+        }
+
+        mSets = std::vector<weight_set>(maxIter + 1);
+        for (int I = 0; I <= maxIter; ++I)
+        {
+            auto &ws = mSets[I];
+            ws.mode = SCALAR;
+            ws.scalar = 1.;
+
+            for (const auto &e : entries)
+            {
+                if (e.iter < 0 || e.iter == I)
+                    ws.mode = std::max(ws.mode, e.kind);
+            }
+
+            // refine from coarse to fine, entries for all iterations
+            // are overridden by those of the specific iteration
+            auto assign = [&](granularity kind, auto &&set) {
+                for (int pass = 0; pass < 2; ++pass)
+                {
+                    for (const auto &e : entries)
+                    {
+                        if (e.kind == kind && ((pass == 0 && e.iter < 0) || (pass == 1 && e.iter == I)))
+                            set(e);
+                    }
+                }
+            };
+
+            assign(SCALAR, [&](const weight_entry &e) { ws.scalar = e.value; });
+
+            if (ws.mode >= DEGREE)
+            {
+                ws.byDegree = vec_double_t(code->max_degree() + 1, ws.scalar);
+                assign(DEGREE, [&](const weight_entry &e) { ws.byDegree[e.index] = e.value; });
+            }
+
+            if (ws.mode >= CHECK)
+            {
+                ws.byCheck = vec_double_t(code->mc());
+                for (int i = 0; i < code->mc(); ++i)
+                {
+                    ws.byCheck[i] = ws.byDegree[code->check_neighbor()[i].size()];
+                }
+                assign(CHECK, [&](const weight_entry &e) { ws.byCheck[e.index] = e.value; });
+            }
+
+            if (ws.mode == EDGE)
+            {
+                ws.byEdge = vec_double_t(code->nnz());
+                for (int i = 0; i < code->nnz(); ++i)
+                {
+                    ws.byEdge[i] = ws.byCheck[code->H().nz_entry()[i].rowIndex];
+                }
+                assign(EDGE, [&](const weight_entry &e) { ws.byEdge[e.index] = e.value; });
+            }
+        }
+    }
+
+    double cn_weights::weight(const u32 iter, const int check, const int edge) const
+    {
+        const auto &w = mSets[std::min<u64>(iter, mSets.size() - 1)];
+        switch (w.mode)
+        {
+        case DEGREE:
+            return w.byDegree[mLdpcCode->check_neighbor()[check].size()];
+        case CHECK:
+            return w.byCheck[check];
+        case EDGE:
+            return w.byEdge[edge];
+        default:
+            return w.scalar;
+        }
+    }
+} // namespace ldpc
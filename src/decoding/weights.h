@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../core/ldpc.h"
+
+namespace ldpc
+{
+    /**
+     * @brief CN message weights for weighted (neural) min-sum decoding.
+     * 
+     * The weight file holds one entry per line: iteration, check, edge and
+     * weight, where '*' matches all iterations, checks or edges and dN
+     * matches all checks of degree N. The edge is the index of the entry
+     * in the parity-check matrix file. Later iterations reuse the weights
+     * of the last iteration given. Weights of an iteration are stored at
+     * the coarsest granularity covering all its entries, so shared weights
+     * do not add memory traffic to the CN update.
+     */
+    class cn_weights
+    {
+    public:
+        enum granularity
+        {
+            SCALAR = 0,
+            DEGREE,
+            CHECK,
+            EDGE
+        };
+
+        cn_weights() = default;
+
+        /**
+         * @brief Read the weights from file.
+         * 
+         * @throw runtime_error
+         * @param filename Weight file
+         * @param code LDPC code the weights are trained for
+         */
+        cn_weights(const std::string &filename, const std::shared_ptr<ldpc_code> &code);
+
+        /**
+         * @brief Weight the outgoing messages of a check.
+         * 
+         * @param iter Iteration
+         * @param check Check node index
+         * @param cn Neighbours of the check in the decoding graph
+         * @param c2v CN to VN messages
+         */
+        void apply(const u32 iter, const int check, const std::vector<node> &cn, vec_double_t &c2v) const
+        {
+            const auto &w = mSets[std::min<u64>(iter, mSets.size() - 1)];
+            switch (w.mode)
+            {
+            case SCALAR:
+                scale(cn, c2v, w.scalar);
+                break;
+            case DEGREE:
+                scale(cn, c2v, w.byDegree[cn.size()]);
+                break;
+            case CHECK:
+                scale(cn, c2v, w.byCheck[check]);
+                break;
+            case EDGE:
+                for (const auto &n : cn)
+                {
+                    c2v[n.edgeIndex] *= w.byEdge[n.edgeIndex];
+                }
+                break;
+            }
+        }
+
+        /**
+         * @brief Weight of a single edge.
+         * 
+         * @param iter Iteration
+         * @param check Check node index
+         * @param edge Edge index
+         * @return double Weight
+         */
+        double weight(const u32 iter, const int check, const int edge) const;
+
+        // Granularity the weights of an iteration are stored at
+        granularity mode(const u32 iter) const { return mSets[std::min<u64>(iter, mSets.size() - 1)].mode; }
+
+    private:
+        static void scale(const std::vector<node> &cn, vec_double_t &c2v, const double w)
+        {
+            for (const auto &n : cn)
+            {
+                c2v[n.edgeIndex] *= w;
+            }
+        }
+
+        struct weight_set
+        {
+            granularity mode;
+            double scalar;
+            vec_double_t byDegree;
+            vec_double_t byCheck;
+            vec_double_t byEdge;
+        };
+
+        std::shared_ptr<ldpc_code> mLdpcCode;
+        std::vector<weight_set> mSets;
+    };
+} // namespace ldpc
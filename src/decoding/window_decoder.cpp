@@ -0,0 +1,211 @@
+#include "window_decoder.h"
+
+namespace ldpc
+{
+    // message of a check with a single bit, i.e. the bit is known to be zero
+    constexpr double CERTAIN_LLR = 99999.9;
+
+    sc_window_decoder::sc_window_decoder(const std::shared_ptr<sc_ldpc_code> &code,
+                                         const decoder_param &decoderParam,
+                                         const int window)
+        : mSCCode(code),
+          mCNApprox(ldpc::jacobian),
+          mWindow(window),
+          mTarget(0),
+          mRowN(code->mb(), std::vector<sc_node>()),
+          mColN(code->nb(), std::vector<sc_node>()),
+          mLc2v(static_cast<u64>(window) * code->nnz_position()),
+          mApp(static_cast<u64>(window + code->coupling_width()) * code->nb()),
+          mLLRIn(code->nc()), mLLROut(code->nc()),
+          mCO(code->nc())
+    {
+        if (mWindow <= mSCCode->coupling_width())
+            throw std::runtime_error("sc_window_decoder(): window must exceed the coupling width");
+
+        for (int k = 0; k <= mSCCode->coupling_width(); ++k)
+        {
+            const auto &h = mSCCode->components()[k];
+            const auto offset = mSCCode->edge_offset()[k];
+
+            for (int r = 0; r < mSCCode->mb(); ++r)
+            {
+                for (const auto &n : h.row_neighbor()[r])
+                    mRowN[r].push_back(sc_node({k, n.nodeIndex, offset + n.edgeIndex}));
+            }
+            for (int c = 0; c < mSCCode->nb(); ++c)
+            {
+                for (const auto &n : h.col_neighbor()[c])
+                    mColN[c].push_back(sc_node({k, n.nodeIndex, offset + n.edgeIndex}));
+            }
+        }
+
+        auto maxDegree = std::max_element(mRowN.begin(), mRowN.end(),
+                                          [](const auto &a, const auto &b) { return (a.size() < b.size()); })->size();
+        mLv2c = vec_double_t(maxDegree);
+        mSlot = vec_int(maxDegree);
+        mExMsgF = vec_double_t(maxDegree);
+        mExMsgB = vec_double_t(maxDegree);
+
+        set_param(decoderParam);
+    }
+
+    void sc_window_decoder::set_param(const decoder_param &param)
+    {
+        mDecoderParam = param;
+        mCNApprox = ldpc::jacobian;
+        if (mDecoderParam.type == std::string("BP_MS"))
+        {
+            mCNApprox = ldpc::minsum;
+        }
+    }
+
+    void sc_window_decoder::cn_update(const int t, const int r)
+    {
+        const auto &rn = mRowN[r];
+
+        // gather the edges present at this position of the chain
+        u64 cw = 0;
+        for (u64 i = 0; i < rn.size(); ++i)
+        {
+            auto j = t - rn[i].component;
+            if (j < 0 || j >= mSCCode->chain_length())
+                continue;
+
+            mLv2c[cw] = app(j, rn[i].nodeIndex) - c2v(t, rn[i].edgeIndex);
+            mSlot[cw] = i;
+            ++cw;
+        }
+
+        if (cw == 0)
+            return;
+
+        if (cw == 1)
+        {
+            set_c2v(t, rn[mSlot[0]], CERTAIN_LLR);
+            return;
+        }
+
+        mExMsgF[0] = mLv2c[0];
+        mExMsgB[cw - 1] = mLv2c[cw - 1];
+        for (u64 j = 1; j < cw; ++j)
+        {
+            mExMsgF[j] = mCNApprox(mExMsgF[j - 1], mLv2c[j]);
+            mExMsgB[cw - 1 - j] = mCNApprox(mExMsgB[cw - j], mLv2c[cw - j - 1]);
+        }
+
+        set_c2v(t, rn[mSlot[0]], mExMsgB[1]);
+        set_c2v(t, rn[mSlot[cw - 1]], mExMsgF[cw - 2]);
+        for (u64 j = 1; j < cw - 1; ++j)
+        {
+            set_c2v(t, rn[mSlot[j]], mCNApprox(mExMsgF[j - 1], mExMsgB[j + 1]));
+        }
+    }
+
+    void sc_window_decoder::set_c2v(const int t, const sc_node &n, const double msg)
+    {
+        // messages to decided columns are frozen, so these keep
+        // sending their extrinsic LLR at the time of decision
+        if (t - n.component >= mTarget)
+            c2v(t, n.edgeIndex) = msg;
+    }
+
+    bool sc_window_decoder::window_satisfied(const int rowBegin, const int rowEnd) const
+    {
+        // every check of the window only involves columns of the window
+        for (int t = rowBegin; t < rowEnd; ++t)
+        {
+            for (int r = 0; r < mSCCode->mb(); ++r)
+            {
+                bits_t s = 0;
+                for (const auto &n : mRowN[r])
+                {
+                    auto j = t - n.component;
+                    if (j >= 0 && j < mSCCode->chain_length())
+                        s += mCO[j * mSCCode->nb() + n.nodeIndex];
+                }
+
+                if (s != 0)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    int sc_window_decoder::decode()
+    {
+        const int L = mSCCode->chain_length();
+        const int nb = mSCCode->nb();
+        const int rowsTotal = L + mSCCode->coupling_width();
+
+        // initial window
+        for (int j = 0; j < std::min(mWindow, L); ++j)
+        {
+            for (int c = 0; c < nb; ++c)
+                app(j, c) = mLLRIn[j * nb + c];
+        }
+        std::fill(mLc2v.begin(), mLc2v.end(), 0.);
+
+        int iters = 0;
+        for (int p = 0; p < L; ++p)
+        {
+            mTarget = p;
+            const int rowEnd = std::min(p + mWindow, rowsTotal);
+            const int colEnd = std::min(p + mWindow, L);
+
+            for (unsigned I = 0; I < mDecoderParam.iterations; ++I)
+            {
+                ++iters;
+
+                // CN processing of all rows in the window
+                for (int t = p; t < rowEnd; ++t)
+                {
+                    for (int r = 0; r < mSCCode->mb(); ++r)
+                        cn_update(t, r);
+                }
+
+                // VN processing of the undecided columns, rows beyond the
+                // window have not been activated yet
+                for (int j = p; j < colEnd; ++j)
+                {
+                    for (int c = 0; c < nb; ++c)
+                    {
+                        double llr = mLLRIn[j * nb + c];
+                        for (const auto &n : mColN[c])
+                        {
+                            auto t = j + n.component;
+                            if (t < rowEnd)
+                                llr += c2v(t, n.edgeIndex);
+                        }
+
+                        app(j, c) = llr;
+                        mCO[j * nb + c] = (llr <= 0);
+                    }
+                }
+
+                if (mDecoderParam.earlyTerm && window_satisfied(p, rowEnd))
+                    break;
+            }
+
+            // decide the target position, its APP is frozen from now on
+            for (int c = 0; c < nb; ++c)
+            {
+                mLLROut[p * nb + c] = app(p, c);
+                mCO[p * nb + c] = (app(p, c) <= 0);
+            }
+
+            // slide the window by one position
+            if (p + mWindow < rowsTotal)
+            {
+                auto row = mLc2v.begin() + static_cast<u64>((p + mWindow) % mWindow) * mSCCode->nnz_position();
+                std::fill(row, row + mSCCode->nnz_position(), 0.);
+            }
+            if (p + mWindow < L)
+            {
+                for (int c = 0; c < nb; ++c)
+                    app(p + mWindow, c) = mLLRIn[(p + mWindow) * nb + c];
+            }
+        }
+
+        return iters;
+    }
+} // namespace ldpc
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "decoder.h"
+#include "../core/sc_ldpc.h"
+
+namespace ldpc
+{
+    // neighbour of a block row or column within the coupled chain
+    struct sc_node
+    {
+        int component; // component index k, i.e. position offset
+        int nodeIndex; // column index (of row neighbours) or row index (of column neighbours)
+        int edgeIndex; // edge slot within the block row
+    };
+
+    /**
+     * @brief Sliding-window BP decoder for spatially-coupled LDPC codes.
+     *
+     * Only the messages of W block rows and the APP LLRs of W + w block
+     * columns are kept, so memory is bounded by the window size and a
+     * position is decided after W positions have been received.
+     */
+    class sc_window_decoder
+    {
+    public:
+        sc_window_decoder() = default;
+        sc_window_decoder(const std::shared_ptr<sc_ldpc_code> &code,
+                          const decoder_param &decoderParam,
+                          const int window);
+        virtual ~sc_window_decoder() = default;
+
+        /**
+         * @brief Decode the whole chain position by position. The iteration
+         * limit of decoder_param applies to each window.
+         *
+         * @return int Total number of window iterations
+         */
+        int decode();
+
+        // Set the input LLR of the chain
+        void set_llr_in(const vec_double_t &in) { mLLRIn = in; }
+
+        // Get the output LLR of the chain
+        const vec_double_t &llr_out() const { return mLLROut; }
+
+        // The estimated codeword of the chain
+        const vec_bits_t &estimate() const { return mCO; }
+
+        // Set the decoder parameters & update the CN approximation operation
+        void set_param(const decoder_param &param);
+
+        // Window size W in positions
+        int window() const { return mWindow; }
+
+    private:
+        void cn_update(const int t, const int r);
+        void set_c2v(const int t, const sc_node &n, const double msg);
+        bool window_satisfied(const int rowBegin, const int rowEnd) const;
+
+        double &c2v(const int t, const int slot) { return mLc2v[(t % mWindow) * mSCCode->nnz_position() + slot]; }
+        double &app(const int j, const int c) { return mApp[(j % (mWindow + mSCCode->coupling_width())) * mSCCode->nb() + c]; }
+
+        std::shared_ptr<sc_ldpc_code> mSCCode;
+
+        decoder_param mDecoderParam;
+
+        // CN approximation operation
+        std::function<double(double, double)> mCNApprox;
+
+        int mWindow;
+        // target position, i.e. first undecided position of the window
+        int mTarget;
+
+        // neighbours of a block row/column over all components
+        std::vector<std::vector<sc_node>> mRowN;
+        std::vector<std::vector<sc_node>> mColN;
+
+        // window resident messages, ring buffers over positions
+        vec_double_t mLc2v;
+        vec_double_t mApp;
+
+        // auxillary vectors for the CN update
+        vec_double_t mLv2c;
+        vec_int mSlot;
+        vec_double_t mExMsgF;
+        vec_double_t mExMsgB;
+
+        vec_double_t mLLRIn;
+        vec_double_t mLLROut;
+        vec_bits_t mCO;
+    };
+} // namespace ldpc
@@ -0,0 +1,53 @@
+#include "core/ldpc.h"
+#include "core/bit_matrix.h"
+#include "../include/argparse/argparse.hpp"
+
+#include <omp.h>
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("ldpcgen");
+    parser.add_argument("codefile").help("LDPC codefile containing all non-zero entries, compressed sparse row (CSR) format.");
+    parser.add_argument("output-file").help("Generator matrix file, compressed sparse row (CSR) format.");
+
+    parser.add_argument("-t", "--num-threads").help("Number of threads for the row reduction. (Default: 1)").default_value(unsigned(1)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("--full-dimension").help("One row per dimension of the code, otherwise N-M rows spanning a subcode if H has redundant checks.").default_value(false).implicit_value(true);
+    parser.add_argument("--perm-file").help("Writes the column permutation, information columns followed by parity columns.").default_value(std::string(""));
+
+    try
+    {
+        parser.parse_args(argc, argv);
+
+        ldpc::ldpc_code code(parser.get<std::string>("codefile"));
+        omp_set_num_threads(parser.get<ldpc::u32>("--num-threads"));
+
+        ldpc::vec_int perm;
+        auto start = std::chrono::high_resolution_clock::now();
+        auto G = ldpc::generator_matrix(code.H(), perm, parser.get<bool>("--full-dimension") ? -1 : code.kc());
+        auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+        G.write_to_file(parser.get<std::string>("output-file"));
+
+        auto permFile = parser.get<std::string>("--perm-file");
+        if (!permFile.empty())
+        {
+            std::ofstream out(permFile);
+            for (auto p : perm)
+                out << p << " ";
+            out << "\n";
+        }
+
+        std::cout << "N : " << code.nc() << "\n";
+        std::cout << "M : " << code.mc() << "\n";
+        std::cout << "K (rows of G) : " << G.num_rows() << "\n";
+        std::cout << "Time : " << time << "ms" << std::endl;
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << parser;
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
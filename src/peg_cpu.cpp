@@ -0,0 +1,89 @@
+#include "core/ldpc.h"
+#include "core/peg.h"
+#include "../include/argparse/argparse.hpp"
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("ldpcpeg");
+    parser.add_argument("output-file").help("Parity-check matrix file, CSR format, or QC base matrix if -Z is given.");
+    parser.add_argument("-n", "--num-vars").required().help("Number of variable nodes, base columns with -Z.").action([](const std::string &s) { return std::stoi(s); });
+    parser.add_argument("-m", "--num-checks").required().help("Number of check nodes, base rows with -Z.").action([](const std::string &s) { return std::stoi(s); });
+    parser.add_argument("-d", "--degrees").help("Variable degree distribution, node perspective, as degree:fraction pairs. (Default: 3:1)").default_value(std::string("3:1"));
+    parser.add_argument("-Z", "--lifting").help("Lifting size for QC-PEG, 0 for PEG. (Default: 0)").default_value(int(0)).action([](const std::string &s) { return std::stoi(s); });
+    parser.add_argument("--ace").help("Break ties by the ACE of the closed cycles.").default_value(false).implicit_value(true);
+    parser.add_argument("--max-depth").help("BFS depth in check levels, 0 for unlimited. (Default: 0)").default_value(unsigned(0)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("--max-reach").help("Checks a BFS may reach before it stops, 0 for unlimited. (Default: 0)").default_value(unsigned(0)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("-s", "--seed").help("RNG seed. (Default: 0)").default_value(ldpc::u64(0)).action([](const std::string &s) { return std::stoull(s); });
+
+    try
+    {
+        parser.parse_args(argc, argv);
+
+        // "2:0.5,3:0.5"
+        std::vector<std::pair<int, double>> dist;
+        std::stringstream ss(parser.get<std::string>("--degrees"));
+        for (std::string pair; std::getline(ss, pair, ',');)
+        {
+            auto colon = pair.find(':');
+            if (colon == std::string::npos)
+                throw std::runtime_error("invalid degree distribution");
+            dist.push_back(std::make_pair(std::stoi(pair.substr(0, colon)), std::stod(pair.substr(colon + 1))));
+        }
+
+        ldpc::peg_param param;
+        param.seed = parser.get<ldpc::u64>("--seed");
+        param.maxDepth = parser.get<unsigned>("--max-depth");
+        param.maxReach = parser.get<unsigned>("--max-reach");
+        param.ace = parser.get<bool>("--ace");
+
+        const int n = parser.get<int>("--num-vars");
+        const int m = parser.get<int>("--num-checks");
+        const int Z = parser.get<int>("--lifting");
+        auto degrees = ldpc::degree_sequence(n, dist);
+
+        std::ofstream out(parser.get<std::string>("output-file"));
+        if (!out.good())
+            throw std::runtime_error("can not open file for writing");
+
+        auto start = std::chrono::high_resolution_clock::now();
+        if (Z > 0)
+        {
+            auto qc = ldpc::qc_peg(m, degrees, Z, param);
+            auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+            out << qc.base_cols() << " " << qc.base_rows() << " " << qc.lift() << "\n";
+            for (const auto &row : qc.exponents())
+            {
+                for (auto s : row)
+                    out << s << " ";
+                out << "\n";
+            }
+
+            std::cout << "N : " << qc.num_cols() << "\n";
+            std::cout << "M : " << qc.num_rows() << "\n";
+            std::cout << "NNZ : " << qc.nnz() << "\n";
+            std::cout << "Time : " << time << "ms" << std::endl;
+        }
+        else
+        {
+            auto H = ldpc::peg(m, degrees, param);
+            auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+            for (const auto &e : H.nz_entry())
+                out << e.rowIndex << " " << e.colIndex << "\n";
+
+            std::cout << "N : " << H.num_cols() << "\n";
+            std::cout << "M : " << H.num_rows() << "\n";
+            std::cout << "NNZ : " << H.nz_entry().size() << "\n";
+            std::cout << "Time : " << time << "ms" << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << parser;
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 // Shared library wrapper
 #include "sim/ldpcsim.h"
+#include "core/density_evolution.h"
 
 static std::shared_ptr<ldpc::ldpc_code> ldpcCode;
 static std::shared_ptr<ldpc::ldpc_decoder> ldpcDecoder;
@@ -29,19 +30,34 @@ extern "C"
         sim.start(stopFlag);
     }
 
+    double threshold(de_param param)
+    {
+        // NaN if there is none in the search range
+        return de_threshold(degree_distribution_of(*ldpcCode), param);
+    }
+
     int calculate_rank()
     {
         return ldpcCode->H().rank();
     }
 
-    void encode(uint8_t *infoWord, uint8_t *codeWord)
+    int encode(uint8_t *infoWord, uint8_t *codeWord)
     {
-        vec_bits_t u(infoWord, infoWord + ldpcCode->kct());
-        auto cw = ldpcCode->G().multiply_left(u);
+        if (!ldpcCode->has_encoder())
+        {
+            return -1;
+        }
+
+        // G if given, otherwise H
+        vec_bits_t u(ldpcCode->kc(), 0);
+        std::copy(infoWord, infoWord + ldpcCode->kct(), u.begin());
+        vec_bits_t cw(ldpcCode->nc());
+        ldpcCode->encode(u, cw);
         for (int i = 0; i < ldpcCode->nct(); ++i)
         {
             codeWord[i] = cw[ldpcCode->bit_pos()[i]].value;
         }
+        return 0;
     }
 
     int decode(ldpc::decoder_param decoderParams, double *llr, double *llrOut)
@@ -64,6 +80,21 @@ extern "C"
         return iter;
     }
 
+    int resume(double *llr, double *llrOut)
+    {
+        // LLR of a further transmission over all n bits, zero if not received
+        ldpc::vec_double_t llrIn(llr, llr + ldpcCode->nc());
+        ldpcDecoder->combine_llr(llrIn);
+
+        int iter = ldpcDecoder->resume();
+        for (int i = 0; i < ldpcCode->nct(); ++i)
+        {
+            llrOut[i] = ldpcDecoder->llr_out()[ldpcCode->bit_pos()[i]];
+        }
+
+        return iter;
+    }
+
     void syndrome(uint8_t* word, uint8_t* syndrome)
     {
         vec_bits_t v(word, word + ldpcCode->nc());
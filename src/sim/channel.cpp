@@ -9,9 +9,14 @@ namespace ldpc
           mLdpcDecoder(std::make_shared<ldpc_decoder>(code, decoderParams)),
           mRNG(seed),
           mRandInfoWord(std::bind(std::bernoulli_distribution(0.5), std::mt19937_64(seed << 1))),
+          mInfoTx(code->info_tx()),
           mInfoWord(vec_bits_t(code->kc(), 0)),
           mCodeWord(vec_bits_t(code->nc(), 0))
     {
+        if (decoderParams.crcPoly != 0)
+        {
+            mCRC = std::make_shared<crc>(decoderParams.crcPoly);
+        }
     }
 
     void channel::set_channel_param(const double channelParam) {}
@@ -20,6 +25,10 @@ namespace ldpc
     void channel::calculate_llrs() {}
     int channel::decode() { return 0; }
     const vec_bits_t &channel::estimate() const { return mCodeWord; }
+    u32 channel::stage() const { return 0; }
+    void channel::retransmit(const u32 part, const u32 parts) {}
+    int channel::resume() { return 0; }
+    bool channel::decoded() { return true; }
 
     channel_awgn::channel_awgn(const std::shared_ptr<ldpc_code> &code,
                                const decoder_param &decoderParams,
@@ -43,12 +52,17 @@ namespace ldpc
 
     void channel_awgn::encode_and_map()
     {
-        for (auto &u : mInfoWord)
+        for (auto i : mInfoTx)
         {
-            u = mRandInfoWord();
+            mInfoWord[i] = mRandInfoWord();
         }
 
-        mLdpcCode->G().multiply_left(mInfoWord, mCodeWord);
+        if (mCRC)
+        {
+            mCRC->append(mInfoWord, mInfoTx);
+        }
+
+        mLdpcCode->encode(mInfoWord, mCodeWord);
 
         // only select transmitted codeword bits
         for (int i = 0; i < mLdpcCode->nct(); ++i)
@@ -92,6 +106,20 @@ namespace ldpc
         }
     }
 
+    void channel_awgn::retransmit(const u32 part, const u32 parts)
+    {
+        const auto &p = mLdpcCode->puncture();
+
+        vec_double_t llr(mLdpcCode->nc(), 0.0);
+        for (u64 i = (part - 1) * p.size() / parts; i < part * p.size() / parts; ++i)
+        {
+            auto y = mRandNormal() + (1 - 2 * mCodeWord[p[i]].value);
+            llr[p[i]] = 2 * y / mSigma2;
+        }
+
+        mLdpcDecoder->combine_llr(llr);
+    }
+
     channel_bsc::channel_bsc(const std::shared_ptr<ldpc_code> &code,
                              const decoder_param &decoderParams,
                              const u64 seed,
@@ -106,12 +134,17 @@ namespace ldpc
 
     void channel_bsc::encode_and_map()
     {
-        for (auto &u : mInfoWord)
+        for (auto i : mInfoTx)
+        {
+            mInfoWord[i] = mRandInfoWord();
+        }
+
+        if (mCRC)
         {
-            u = mRandInfoWord();
+            mCRC->append(mInfoWord, mInfoTx);
         }
 
-        mLdpcCode->G().multiply_left(mInfoWord, mCodeWord);
+        mLdpcCode->encode(mInfoWord, mCodeWord);
 
         // only select transmitted codeword bits
         for (int i = 0; i < mLdpcCode->nct(); ++i)
@@ -161,6 +194,21 @@ namespace ldpc
         }
     }
 
+    void channel_bsc::retransmit(const u32 part, const u32 parts)
+    {
+        const double delta = log((1 - mEpsilon) / mEpsilon);
+        const auto &p = mLdpcCode->puncture();
+
+        vec_double_t llr(mLdpcCode->nc(), 0.0);
+        for (u64 i = (part - 1) * p.size() / parts; i < part * p.size() / parts; ++i)
+        {
+            auto y = mCodeWord[p[i]] + mRandBernoulli();
+            llr[p[i]] = delta * (1 - 2 * y.value);
+        }
+
+        mLdpcDecoder->combine_llr(llr);
+    }
+
     channel_bec::channel_bec(const std::shared_ptr<ldpc_code> &code,
                              const decoder_param &decoderParams,
                              const u64 seed,
@@ -176,12 +224,17 @@ namespace ldpc
 
     void channel_bec::encode_and_map()
     {
-        for (auto &u : mInfoWord)
+        for (auto i : mInfoTx)
+        {
+            mInfoWord[i] = mRandInfoWord();
+        }
+
+        if (mCRC)
         {
-            u = mRandInfoWord();
+            mCRC->append(mInfoWord, mInfoTx);
         }
 
-        mLdpcCode->G().multiply_left(mInfoWord, mCodeWord);
+        mLdpcCode->encode(mInfoWord, mCodeWord);
 
         // only select transmitted codeword bits
         for (int i = 0; i < mLdpcCode->nct(); ++i)
@@ -23,6 +23,19 @@ namespace ldpc
         virtual int decode();
         virtual const vec_bits_t &estimate() const;
 
+        // Stage of the decoding cascade that produced the estimate
+        virtual u32 stage() const;
+
+        // IR-HARQ: transmit part r = 1..parts of the punctured bits and
+        // combine their LLRs with the decoder state
+        virtual void retransmit(const u32 part, const u32 parts);
+
+        // IR-HARQ: resume decoding after a retransmission
+        virtual int resume();
+
+        // Whether the estimate satisfies the checks, i.e. no retransmission is requested
+        virtual bool decoded();
+
         // Current transmitted codeword
         const vec_bits_t &codeword() const { return mCodeWord; }
 
@@ -42,6 +55,12 @@ namespace ldpc
         // RNG for encoding information word
         std::function<bool()> mRandInfoWord;
 
+        // CRC appended to the information word, if configured
+        std::shared_ptr<crc> mCRC;
+
+        // Transmitted bits of the information word, the shortened ones stay zero
+        vec_int mInfoTx;
+
         // Information word
         vec_bits_t mInfoWord;
         vec_bits_t mCodeWord;
@@ -103,6 +122,45 @@ namespace ldpc
             return mLdpcDecoder->estimate();
         }
 
+        /**
+         * @brief Stage of the decoding cascade that produced the estimate.
+         * 
+         * @return u32 Stage index
+         */
+        u32 stage() const override
+        {
+            return mLdpcDecoder->stage();
+        }
+
+        /**
+         * @brief Transmit a part of the punctured bits and combine their
+         * LLRs with the decoder state.
+         * 
+         * @param part Part r = 1..parts
+         * @param parts Number of parts the punctured bits are split into
+         */
+        void retransmit(const u32 part, const u32 parts) override;
+
+        /**
+         * @brief Resume decoding from the decoder state.
+         * 
+         * @return int Number of iterations
+         */
+        int resume() override
+        {
+            return mLdpcDecoder->resume();
+        }
+
+        /**
+         * @brief Whether the estimate satisfies all checks.
+         * 
+         * @return true If no retransmission is requested
+         */
+        bool decoded() override
+        {
+            return mLdpcDecoder->is_codeword();
+        }
+
     private:
         //channel i/o
         vec_double_t mX;
@@ -171,6 +229,45 @@ namespace ldpc
             return mLdpcDecoder->estimate();
         }
 
+        /**
+         * @brief Stage of the decoding cascade that produced the estimate.
+         * 
+         * @return u32 Stage index
+         */
+        u32 stage() const override
+        {
+            return mLdpcDecoder->stage();
+        }
+
+        /**
+         * @brief Transmit a part of the punctured bits and combine their
+         * LLRs with the decoder state.
+         * 
+         * @param part Part r = 1..parts
+         * @param parts Number of parts the punctured bits are split into
+         */
+        void retransmit(const u32 part, const u32 parts) override;
+
+        /**
+         * @brief Resume decoding from the decoder state.
+         * 
+         * @return int Number of iterations
+         */
+        int resume() override
+        {
+            return mLdpcDecoder->resume();
+        }
+
+        /**
+         * @brief Whether the estimate satisfies all checks.
+         * 
+         * @return true If no retransmission is requested
+         */
+        bool decoded() override
+        {
+            return mLdpcDecoder->is_codeword();
+        }
+
     private:
         //channel i/o
         vec_bits_t mX;
@@ -73,6 +73,20 @@ namespace ldpc
                     throw std::runtime_error("No channel selected.");
                 }
             }            
+
+            if (!mLdpcCode->has_encoder())
+            {
+                std::cout << "Warning: no encoder for the code, simulating the all-zero codeword" << std::endl;
+            }
+
+            if (mSimulationParams.transmissions < 1)
+            {
+                throw std::runtime_error("At least one transmission per frame required.");
+            }
+            if (mSimulationParams.transmissions > 1 && (mChannelParams.type == std::string("BEC") || mLdpcCode->puncture().empty()))
+            {
+                throw std::runtime_error("IR-HARQ requires punctured bits and the AWGN or BSC channel.");
+            }
         }
         catch (std::exception &e)
         {
@@ -100,6 +114,7 @@ namespace ldpc
         u64 bec = 0;
         u64 fec = 0;
         u64 iters;
+        u64 transmissions;
 
         ldpc::vec_double_t xVals;
         double val = mChannelParams.xRange[0];
@@ -121,6 +136,10 @@ namespace ldpc
             std::reverse(xVals.begin(), xVals.end());
         }
 
+        // frames handled by each stage of a decoding cascade
+        auto stages = cascade_stages(mDecoderParams.type);
+        std::vector<u64> stageFrames(stages.size(), 0);
+
         std::vector<std::string> printResStr(xVals.size() + 1, std::string());
         std::ofstream fp;
         char resStr[128];
@@ -131,6 +150,17 @@ namespace ldpc
         #else
         printResStr[0].assign("snr fer ber frames avg_iter");
         #endif
+        if (stages.size() > 1)
+        {
+            for (const auto &s : stages)
+            {
+                printResStr[0].append(" frac_" + s);
+            }
+        }
+        if (mSimulationParams.transmissions > 1)
+        {
+            printResStr[0].append(" avg_tx");
+        }
         #endif
 
 
@@ -144,13 +174,16 @@ namespace ldpc
             fec = 0;
             frames = 0;
             iters = 0;
+            transmissions = 0;
+            std::fill(stageFrames.begin(), stageFrames.end(), 0);
 
             auto timeStart = std::chrono::high_resolution_clock::now();
 
             #pragma omp parallel default(none)                                   \
                 num_threads(mSimulationParams.threads)                           \
                 shared(iters, stopFlag, timeStart, mChannel, fec, xVals, stdout, \
-                    bec, frames, printResStr, fp, resStr, minFec, maxFrames, i)
+                    bec, frames, printResStr, fp, resStr, minFec, maxFrames, i, \
+                    stages, stageFrames, transmissions)
             {
                 unsigned tid = omp_get_thread_num();
 
@@ -159,7 +192,7 @@ namespace ldpc
 
                 do
                 {
-                    if (!mLdpcCode->G().empty())
+                    if (mLdpcCode->has_encoder())
                     {
                         mChannel[tid]->encode_and_map();
                     }
@@ -172,6 +205,15 @@ namespace ldpc
 
                     //decode
                     auto it = mChannel[tid]->decode();
+
+                    // IR-HARQ, further parts of the punctured bits until the checks are satisfied
+                    u32 tx = 1;
+                    for (; tx < mSimulationParams.transmissions && !mChannel[tid]->decoded(); ++tx)
+                    {
+                        mChannel[tid]->retransmit(tx, mSimulationParams.transmissions - 1);
+                        it += mChannel[tid]->resume();
+                    }
+
                     #pragma omp atomic update
                     iters += it;
 
@@ -180,6 +222,13 @@ namespace ldpc
                         #pragma omp atomic update
                         ++frames;
 
+                        auto stage = mChannel[tid]->stage();
+                        #pragma omp atomic update
+                        ++stageFrames[stage];
+
+                        #pragma omp atomic update
+                        transmissions += tx;
+
                         // count the bit errors
                         int bec_tmp = 0;
                         for (auto ci : mLdpcCode->bit_pos())
@@ -217,6 +266,19 @@ namespace ldpc
                                         frames, static_cast<double>(iters) / frames);
                                 #endif
                                 printResStr[i + 1].assign(resStr);
+                                if (stages.size() > 1)
+                                {
+                                    for (auto n : stageFrames)
+                                    {
+                                        sprintf(resStr, " %.3e", static_cast<double>(n) / frames);
+                                        printResStr[i + 1].append(resStr);
+                                    }
+                                }
+                                if (mSimulationParams.transmissions > 1)
+                                {
+                                    sprintf(resStr, " %.3e", static_cast<double>(transmissions) / frames);
+                                    printResStr[i + 1].append(resStr);
+                                }
 
                                 try
                                 {
@@ -256,6 +318,19 @@ namespace ldpc
             }
             #ifndef LIB_SHARED
             printf("\n");
+            if (stages.size() > 1 && frames > 0)
+            {
+                printf("        |  stages: ");
+                for (u64 k = 0; k < stages.size(); ++k)
+                {
+                    printf("%s %.2f%%  ", stages[k].c_str(), 100. * stageFrames[k] / frames);
+                }
+                printf("\n");
+            }
+            if (mSimulationParams.transmissions > 1 && frames > 0)
+            {
+                printf("        |  transmissions: %.3f per frame\n", static_cast<double>(transmissions) / frames);
+            }
             #endif
         } //end for
 
@@ -16,10 +16,19 @@ int main(int argc, char *argv[])
     parser.add_argument("-t", "--num-threads").help("Number of frames to be decoded in parallel. (Default: 1)").default_value(unsigned(1)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
 
     parser.add_argument("--channel").help("Specifies channel: \"AWGN\", \"BSC\", \"BEC\" (Default: AWGN)").default_value(std::string("AWGN"));
-    parser.add_argument("--decoding").help("Specifies decoding algorithm: \"BP\", \"BP_MS\" (Default: BP)").default_value(std::string("BP"));
+    parser.add_argument("--decoding").help("Specifies decoding algorithm: \"BP\", \"BP_MS\", \"BP_OMS\", \"BP_WMS\", \"BF\", \"LUT\" or a cascade, e.g. \"BF,BP_OMS,BP\" (Default: BP)").default_value(std::string("BP"));
+    parser.add_argument("--weights").help("CN weight file for weighted min-sum decoding (\"BP_WMS\").").default_value(std::string(""));
+    parser.add_argument("--tables").help("Table file for lookup-table decoding (\"LUT\").").default_value(std::string(""));
+    parser.add_argument("--ms-offset").help("Offset for offset min-sum decoding (\"BP_OMS\"). (Default: 0.5)").default_value(double(0.5)).action([](const std::string &s) { return std::stod(s); });
+    parser.add_argument("--warm-start").help("Cascaded decoding resumes from the messages of the previous stage.").default_value(false).implicit_value(true);
     parser.add_argument("--max-frames").help("Limit number of decoded frames.").default_value(ldpc::u64(10e9)).action([](const std::string &s) { return std::stoul(s); });
     parser.add_argument("--frame-error-count").help("Maximum frame errors for given simulation point.").default_value(ldpc::u64(50)).action([](const std::string &s) { return std::stoul(s); });
+    parser.add_argument("--harq-tx").help("IR-HARQ transmissions per frame, the punctured bits are sent in equal parts. (Default: 1)").default_value(unsigned(1)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
     parser.add_argument("--no-early-term").help("Disable early termination for decoding.").default_value(false).implicit_value(true);
+    parser.add_argument("--block-iterations").help("Local iterations per cache-sized layer, 0 for flooding schedule. (Default: 0)").default_value(unsigned(0)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+    parser.add_argument("--crc").help("CRC polynomial over the information bits used for early termination, e.g. 0x1864CFB. (Default: none)").default_value(ldpc::u64(0)).action([](const std::string &s) { return std::stoul(s, nullptr, 0); });
+    parser.add_argument("--cache-dir").help("Directory of the binary code cache, loaded from and written to. (Default: no cache)").default_value(std::string(""));
+    parser.add_argument("--layer-cache").help("Cache budget per layer in KiB. (Default: 256)").default_value(ldpc::u64(256)).action([](const std::string &s) { return std::stoul(s); });
 
     try
     {
@@ -28,23 +37,31 @@ int main(int argc, char *argv[])
         auto snr = parser.get<ldpc::vec_double_t>("snr-range");
         if (snr[0] > snr[1]) throw std::runtime_error("snr min > snr max");
         
-        auto code = std::make_shared<ldpc::ldpc_code>(parser.get<std::string>("codefile"), parser.get<std::string>("-G"));
+        auto code = std::make_shared<ldpc::ldpc_code>(parser.get<std::string>("codefile"), parser.get<std::string>("-G"), parser.get<std::string>("--cache-dir"), parser.get<ldpc::u64>("--layer-cache") * 1024);
         std::cout << "========================================================================================" << std::endl;
         std::cout << "Parity-Check Matrix: " << parser.get<std::string>("codefile") << std::endl;
         std::cout << "Generator Matrix: " << parser.get<std::string>("-G") << std::endl;
         std::cout << *code << std::endl;
         std::cout << "========================================================================================" << std::endl;
 
-        std::string decType, chType, resFile;
+        std::string decType, chType, resFile, weightFile, tableFile;
         decType = parser.get<std::string>("--decoding");
         chType = parser.get<std::string>("--channel");
         resFile = parser.get<std::string>("output-file");
+        weightFile = parser.get<std::string>("--weights");
+        tableFile = parser.get<std::string>("--tables");
 
         // decoder parameters
         ldpc::decoder_param decoderParams;
         decoderParams.iterations = parser.get<ldpc::u32>("--num-iterations");
         decoderParams.earlyTerm = !parser.get<bool>("--no-early-term");
         decoderParams.type = decType.c_str();
+        decoderParams.blockIterations = parser.get<ldpc::u32>("--block-iterations");
+        decoderParams.crcPoly = parser.get<ldpc::u64>("--crc");
+        decoderParams.weightFile = weightFile.c_str();
+        decoderParams.tableFile = tableFile.c_str();
+        decoderParams.warmStart = parser.get<bool>("--warm-start");
+        decoderParams.msOffset = parser.get<double>("--ms-offset");
 
         // channel parameters
         ldpc::channel_param channelParams;
@@ -61,6 +78,7 @@ int main(int argc, char *argv[])
         simulationParams.fec = parser.get<ldpc::u64>("--frame-error-count");
         simulationParams.maxFrames = parser.get<ldpc::u64>("--max-frames");
         simulationParams.resultFile = resFile.c_str();
+        simulationParams.transmissions = parser.get<ldpc::u32>("--harq-tx");
 
         ldpc::ldpc_sim sim(
             code,
@@ -0,0 +1,52 @@
+#include "core/ldpc.h"
+#include "core/validate.h"
+#include "../include/argparse/argparse.hpp"
+
+#include <omp.h>
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("ldpcvalidate");
+    parser.add_argument("codefile").help("LDPC codefile containing all non-zero entries, compressed sparse row (CSR) format.");
+
+    parser.add_argument("-G", "--gen-matrix").help("Generator matrix file, compressed sparse row (CSR) format, checked against H.").default_value(std::string(""));
+    parser.add_argument("-t", "--num-threads").help("Number of threads for G H^T. (Default: 1)").default_value(unsigned(1)).action([](const std::string &s) { return static_cast<unsigned>(std::stoul(s)); });
+
+    try
+    {
+        parser.parse_args(argc, argv);
+
+        omp_set_num_threads(parser.get<ldpc::u32>("--num-threads"));
+
+        // the files are only parsed, an ldpc_code would reject invalid indices
+        ldpc::sparse_csr<ldpc::bits_t> H, G;
+        ldpc::qc_matrix qc;
+        ldpc::vec_int puncture, shorten;
+        ldpc::ldpc_code::parse_H(parser.get<std::string>("codefile"), H, qc, puncture, shorten);
+        if (!parser.get<std::string>("--gen-matrix").empty())
+        {
+            G.read_from_file(parser.get<std::string>("--gen-matrix"), 0);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto report = ldpc::validate_code(H, G, puncture, shorten);
+        auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+        std::cout << "N : " << H.num_cols() << "\n";
+        std::cout << "M : " << H.num_rows() << "\n";
+        std::cout << "NNZ : " << H.nz_entry().size() << "\n";
+        std::cout << report;
+        std::cout << "Time : " << time << "ms" << std::endl;
+
+        if (!report.valid())
+            exit(EXIT_FAILURE);
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << parser;
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}
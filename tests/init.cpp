@@ -8,13 +8,17 @@ int main(int argc, char *argv[])
     argparse::ArgumentParser parser("ldpc_tests");
     parser.add_argument("codefile").help("LDPC codefile containing all non-zero entries, compressed sparse row (CSR) format.");
     parser.add_argument("-G").help("Generator matrix,  compressed sparse row (CSR) format.").default_value(std::string(""));
+    parser.add_argument("-W").help("CN weight file for weighted min-sum decoding.").default_value(std::string(""));
+    parser.add_argument("-L").help("Table file for lookup-table decoding.").default_value(std::string(""));
 
-    std::string pcFile, genFile;
+    std::string pcFile, genFile, weightFile, tableFile;
     try
     {
         parser.parse_args(argc, argv);
         pcFile = parser.get<std::string>("codefile");
         genFile = parser.get<std::string>("-G");
+        weightFile = parser.get<std::string>("-W");
+        tableFile = parser.get<std::string>("-L");
     }
     catch (const std::runtime_error &e)
     {
@@ -30,12 +34,40 @@ int main(int argc, char *argv[])
         ldpc_tests::rank(code);
         ldpc_tests::is_generator_matrix(code);
         ldpc_tests::codeword(code);
+        ldpc_tests::packed_encoding(code);
+        ldpc_tests::h_encoding(code);
+        ldpc_tests::generator_derivation(code);
+        ldpc_tests::code_cache(pcFile, genFile);
+        ldpc_tests::file_formats(code);
+        ldpc_tests::nr_codes();
+        ldpc_tests::peg_construction();
+        ldpc_tests::cycle_analysis(code);
+        ldpc_tests::min_distance(code);
+        ldpc_tests::trapping_sets();
+        ldpc_tests::density_evolution();
+        ldpc_tests::code_edits(code);
+        ldpc_tests::decoding(code);
+        ldpc_tests::crc(code);
+        if (!weightFile.empty())
+        {
+            ldpc_tests::weighted_min_sum(code, weightFile);
+        }
+        if (!tableFile.empty())
+        {
+            ldpc_tests::lut_decoding(code, tableFile);
+        }
+        ldpc_tests::cascaded_decoding(code);
+        ldpc_tests::harq_decoding(code);
+        ldpc_tests::batch_decoding(code);
+        ldpc_tests::nb_decoding(code);
+        ldpc_tests::sc_window_decoding();
 
         std::cout << "All tests passed." << std::endl;
     }
     catch (const std::exception &e)
     {
         std::cout << "Assessment failed: " << e.what() << std::endl;
+        return EXIT_FAILURE;
     }
 
     return 0;
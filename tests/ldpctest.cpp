@@ -1,4 +1,19 @@
-#include "../src/core/ldpc.h"
+#include "../src/decoding/window_decoder.h"
+#include "../src/decoding/batch_decoder.h"
+#include "../src/decoding/nb_decoder.h"
+#include "../src/core/bit_matrix.h"
+#include "../src/core/nr_code.h"
+#include "../src/core/peg.h"
+#include "../src/core/cycles.h"
+#include "../src/core/distance.h"
+#include "../src/core/trapping_sets.h"
+#include "../src/core/validate.h"
+#include "../src/sim/channel.h"
+#include "../src/core/density_evolution.h"
+
+#include <unordered_set>
+#include <set>
+#include <map>
 
 namespace ldpc_tests
 {
@@ -21,35 +36,73 @@ namespace ldpc_tests
 
     void rank(const ldpc::ldpc_code &code)
     {
-        std::cout << "passed: gf2 rank calculated: " << code.H().rank() << std::endl;
+        // sparse elimination against the dense echelon form
+        auto r = code.H().rank();
+        if (r != static_cast<int>(ldpc::bit_matrix(code.H()).echelonize().size()))
+        {
+            throw std::runtime_error("failed: gf2 rank");
+        }
+        std::cout << "passed: gf2 rank calculated: " << r << std::endl;
     }
 
     void is_generator_matrix(const ldpc::ldpc_code &code)
     {
-        for (int i = 0; i < code.mc(); i++) // rows of H
-        {
-            for (int j = 0; j < code.kc(); j++) // cols of G transpose = rows of G
-            {
-                auto &h = code.H().row_neighbor()[i];
-                auto &g = code.G().row_neighbor()[j];
+        auto report = ldpc::validate_code(code);
+        if (!report.valid() || report.productWeight != 0)
+            throw std::runtime_error("failed: is_generator_matrix");
 
-                auto sum = ldpc::bits_t(0);
-                for (auto hi : h)
-                {
-                    for (auto gj : g)
-                    {
-                        sum += (hi.nodeIndex == gj.nodeIndex) *
-                               code.G().nz_entry()[gj.edgeIndex].value *
-                               code.H().nz_entry()[hi.edgeIndex].value;
-                    }
-                }
+        // a row of G with one bit flipped fails every check of that bit
+        std::vector<ldpc::edge<ldpc::bits_t>> edges = code.G().nz_entry();
+        const int j = edges[0].colIndex;
+        edges.erase(edges.begin());
+        ldpc::sparse_csr<ldpc::bits_t> G(code.G().num_rows(), code.nc(), edges);
+        if (ldpc::product_weight(G, code.H()) != code.H().col_neighbor()[j].size())
+            throw std::runtime_error("failed: G H^T weight");
 
-                if (sum != 0)
-                {
-                    throw std::runtime_error("failed: is_generator_matrix");
-                }
+        // repeated entries and bits both punctured and shortened
+        edges = code.H().nz_entry();
+        edges.push_back(edges[5]);
+        report = ldpc::validate_code(ldpc::sparse_csr<ldpc::bits_t>(code.mc(), code.nc(), edges), ldpc::sparse_csr<ldpc::bits_t>(), {1, code.nc()}, {1});
+        if (report.valid() || report.duplicateEdges != 1 || report.errors.size() != 3)
+            throw std::runtime_error("failed: code validation");
+
+        // a redundant check raises the dimension, a G of full dimension is valid
+        edges = code.H().nz_entry();
+        std::set<int> sum;
+        for (int i : {0, 1})
+        {
+            for (const auto &n : code.H().row_neighbor()[i])
+            {
+                if (!sum.insert(n.nodeIndex).second)
+                    sum.erase(n.nodeIndex);
             }
         }
+        for (auto col : sum)
+        {
+            edges.push_back(ldpc::edge<ldpc::bits_t>({code.mc(), col, 1}));
+        }
+        ldpc::sparse_csr<ldpc::bits_t> Hr(code.mc() + 1, code.nc(), edges);
+        ldpc::vec_int perm;
+        report = ldpc::validate_code(Hr, ldpc::generator_matrix(Hr, perm, -1).to_sparse(), {}, {});
+        if (!report.valid())
+            throw std::runtime_error("failed: validation of a full-dimension G");
+
+        // out-of-range indices of a file are reported, not thrown by ldpc_code
+        const std::string file = "validate_test.txt";
+        {
+            std::ofstream out(file);
+            out << "puncture [1]: " << code.nc() + 5 << "\n";
+            for (const auto &e : code.H().nz_entry())
+                out << e.rowIndex << " " << e.colIndex << "\n";
+        }
+        ldpc::sparse_csr<ldpc::bits_t> H;
+        ldpc::qc_matrix qc;
+        ldpc::vec_int puncture, shorten;
+        ldpc::ldpc_code::parse_H(file, H, qc, puncture, shorten);
+        std::remove(file.c_str());
+        report = ldpc::validate_code(H, ldpc::sparse_csr<ldpc::bits_t>(), puncture, shorten);
+        if (report.valid() || report.errors.size() != 1)
+            throw std::runtime_error("failed: validation of out-of-range indices");
 
         std::cout << "passed: is_generator_matrix" << std::endl;
     }
@@ -74,4 +127,1425 @@ namespace ldpc_tests
 
         std::cout << "passed: encoding random information word" << std::endl;
     }
+
+    void packed_encoding(const ldpc::ldpc_code &code)
+    {
+        const auto &encoder = code.encoder();
+        if (encoder.systematic() != !code.info_pos().empty())
+        {
+            throw std::runtime_error("failed: packed encoder systematic form");
+        }
+
+        // 64 information words, packed and bit-sliced
+        ldpc::vec_u64 us(code.kc(), 0);
+        std::vector<ldpc::vec_bits_t> cw;
+        for (int b = 0; b < 64; ++b)
+        {
+            ldpc::vec_bits_t u(code.kc());
+            for (int i = 0; i < code.kc(); ++i)
+            {
+                u[i] = rand() % 2;
+                us[i] |= static_cast<ldpc::u64>(u[i].value) << b;
+            }
+            cw.push_back(code.G().multiply_left(u));
+
+            if (encoder.encode(u) != cw.back())
+            {
+                throw std::runtime_error("failed: packed encoding");
+            }
+        }
+
+        ldpc::vec_u64 cs(code.nc());
+        encoder.encode_sliced(us, cs);
+        for (int b = 0; b < 64; ++b)
+        {
+            for (int j = 0; j < code.nc(); ++j)
+            {
+                if (((cs[j] >> b) & 1) != cw[b][j].value)
+                {
+                    throw std::runtime_error("failed: bit-sliced encoding");
+                }
+            }
+        }
+
+        std::cout << "passed: packed encoding" << std::endl;
+    }
+
+    void h_encoding(const ldpc::ldpc_code &code)
+    {
+        auto check = [](const ldpc::sparse_csr<ldpc::bits_t> &H, const ldpc::h_encoder &encoder) {
+            for (int t = 0; t < 16; ++t)
+            {
+                ldpc::vec_bits_t u(encoder.k());
+                for (auto &x : u)
+                {
+                    x = rand() % 2;
+                }
+                auto cw = encoder.encode(u);
+                for (auto s : H.multiply_right(cw))
+                {
+                    if (s != 0)
+                    {
+                        throw std::runtime_error("failed: encoding from H");
+                    }
+                }
+                if (!std::equal(u.begin(), u.end(), cw.begin()))
+                {
+                    throw std::runtime_error("failed: encoding from H not systematic");
+                }
+            }
+        };
+
+        // dual-diagonal parity part, back-substitution only
+        const int m = 24, k = 40;
+        std::vector<ldpc::edge<ldpc::bits_t>> edges;
+        for (int i = 0; i < m; ++i)
+        {
+            for (int j = 0; j < k; ++j)
+            {
+                if ((i * 5 + j * 3) % 7 == 0)
+                    edges.push_back(ldpc::edge<ldpc::bits_t>({i, j, 1}));
+            }
+            edges.push_back(ldpc::edge<ldpc::bits_t>({i, k + i, 1}));
+            if (i > 0)
+                edges.push_back(ldpc::edge<ldpc::bits_t>({i, k + i - 1, 1}));
+        }
+        ldpc::sparse_csr<ldpc::bits_t> ira(m, k + m, edges);
+        ldpc::h_encoder encoder(ira);
+        if (encoder.gap() != 0)
+        {
+            throw std::runtime_error("failed: dual-diagonal encoder gap");
+        }
+        check(ira, encoder);
+
+        // no check of degree 1 in the parity part, requires a gap
+        ldpc::sparse_csr<ldpc::bits_t> gapped(3, 5, {{0, 0, 1}, {0, 2, 1}, {0, 3, 1}, {1, 1, 1}, {1, 3, 1}, {1, 4, 1}, {2, 0, 1}, {2, 1, 1}, {2, 2, 1}, {2, 3, 1}, {2, 4, 1}});
+        encoder = ldpc::h_encoder(gapped);
+        if (encoder.gap() == 0)
+        {
+            throw std::runtime_error("failed: encoder gap");
+        }
+        check(gapped, encoder);
+
+        // H of the test code has redundant checks
+        check(code.H(), ldpc::h_encoder(code.H()));
+
+        std::cout << "passed: encoding from H" << std::endl;
+    }
+
+    void generator_derivation(const ldpc::ldpc_code &code)
+    {
+        ldpc::vec_int perm;
+        auto G = ldpc::generator_matrix(code.H(), perm, code.kc()).to_sparse();
+        if (G.num_rows() != code.kc() || static_cast<int>(perm.size()) != code.nc())
+        {
+            throw std::runtime_error("failed: derived generator matrix dimensions");
+        }
+        if (ldpc::generator_matrix(code.H(), perm, 0).num_rows() != 0)
+        {
+            throw std::runtime_error("failed: derived generator matrix without rows");
+        }
+
+        // G H^T = 0
+        ldpc::vec_bits_t u(code.kc());
+        for (int t = 0; t < 16; ++t)
+        {
+            for (auto &x : u)
+            {
+                x = rand() % 2;
+            }
+            auto cw = G.multiply_left(u);
+            for (auto s : code.H().multiply_right(cw))
+            {
+                if (s != 0)
+                {
+                    throw std::runtime_error("failed: derived generator matrix");
+                }
+            }
+
+            // systematic in the information columns of the permutation
+            for (int i = 0; i < code.kc(); ++i)
+            {
+                if (cw[perm[i]] != u[i])
+                {
+                    throw std::runtime_error("failed: derived generator matrix not systematic");
+                }
+            }
+        }
+
+        // PEG codes rarely have an invertible last m columns, G is derived then
+        ldpc::peg_param pegParam;
+        pegParam.maxDepth = 0;
+        pegParam.maxReach = 0;
+        pegParam.ace = false;
+        for (pegParam.seed = 0; pegParam.seed < 10; ++pegParam.seed)
+        {
+            ldpc::ldpc_code peg(ldpc::peg(32, ldpc::vec_int(64, 3), pegParam));
+            if (!peg.has_encoder())
+            {
+                throw std::runtime_error("failed: no encoder for a PEG code");
+            }
+
+            ldpc::vec_bits_t v(peg.kc()), cw(peg.nc());
+            for (int t = 0; t < 4; ++t)
+            {
+                for (auto &x : v)
+                {
+                    x = rand() % 2;
+                }
+                peg.encode(v, cw);
+                for (auto s : peg.H().multiply_right(cw))
+                {
+                    if (s != 0)
+                    {
+                        throw std::runtime_error("failed: encoding a PEG code");
+                    }
+                }
+            }
+        }
+
+        std::cout << "passed: generator matrix derivation" << std::endl;
+    }
+
+    void code_cache(const std::string &pcFile, const std::string &genFile)
+    {
+        // the first construction writes the cache, the second loads it
+        ldpc::ldpc_code parsed(pcFile, genFile, ".");
+        ldpc::ldpc_code cached(pcFile, genFile, ".");
+
+        // a cache of another layer budget is not taken, the code is partitioned for the new one
+        ldpc::ldpc_code small(pcFile, genFile, ".", 1);
+        ldpc::ldpc_code smallRef(pcFile, genFile);
+        smallRef.partition_layers(1);
+        std::remove(("./" + pcFile.substr(pcFile.find_last_of('/') + 1) + ".cache").c_str());
+        if (small.layers() != smallRef.layers())
+        {
+            throw std::runtime_error("failed: code cache of another layer budget");
+        }
+
+        auto same_graph = [](const std::vector<std::vector<ldpc::node>> &a, const std::vector<std::vector<ldpc::node>> &b) {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto &x, const auto &y) {
+                return std::equal(x.begin(), x.end(), y.begin(), y.end(), [](const ldpc::node &u, const ldpc::node &v) {
+                    return u.nodeIndex == v.nodeIndex && u.edgeIndex == v.edgeIndex;
+                });
+            });
+        };
+
+        if (parsed.nc() != cached.nc() || parsed.mc() != cached.mc() || parsed.nnz() != cached.nnz() ||
+            parsed.puncture() != cached.puncture() || parsed.shorten() != cached.shorten() ||
+            parsed.bit_pos() != cached.bit_pos() || parsed.info_pos() != cached.info_pos() ||
+            parsed.pruned_edges() != cached.pruned_edges() || parsed.layers() != cached.layers() ||
+            !same_graph(parsed.check_neighbor(), cached.check_neighbor()) ||
+            !same_graph(parsed.var_neighbor(), cached.var_neighbor()) ||
+            !same_graph(parsed.H().row_neighbor(), cached.H().row_neighbor()) ||
+            !same_graph(parsed.G().col_neighbor(), cached.G().col_neighbor()))
+        {
+            throw std::runtime_error("failed: code cache");
+        }
+
+        ldpc::vec_bits_t u(parsed.kc());
+        ldpc::vec_bits_t c0(parsed.nc()), c1(parsed.nc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        parsed.encode(u, c0);
+        cached.encode(u, c1);
+        if (c0 != c1)
+        {
+            throw std::runtime_error("failed: code cache encoding");
+        }
+
+        std::cout << "passed: code cache" << std::endl;
+    }
+
+    void file_formats(const ldpc::ldpc_code &code)
+    {
+        // alist of H, unpadded row lines
+        std::ostringstream alist;
+        int maxCol = 0, maxRow = 0;
+        for (const auto &c : code.H().col_neighbor())
+            maxCol = std::max<int>(maxCol, c.size());
+        for (const auto &r : code.H().row_neighbor())
+            maxRow = std::max<int>(maxRow, r.size());
+
+        alist << code.nc() << " " << code.mc() << "\n" << maxCol << " " << maxRow << "\n";
+        for (const auto &c : code.H().col_neighbor())
+            alist << c.size() << " ";
+        alist << "\n";
+        for (const auto &r : code.H().row_neighbor())
+            alist << r.size() << " ";
+        alist << "\n";
+        for (const auto &c : code.H().col_neighbor())
+        {
+            for (int k = 0; k < maxCol; ++k)
+                alist << (k < static_cast<int>(c.size()) ? c[k].nodeIndex + 1 : 0) << " ";
+            alist << "\n";
+        }
+        for (const auto &r : code.H().row_neighbor())
+        {
+            for (const auto &n : r)
+                alist << n.nodeIndex + 1 << " ";
+            alist << "\n";
+        }
+
+        auto text = alist.str();
+        ldpc::sparse_csr<ldpc::bits_t> H;
+        H.parse_alist(text.data(), text.data() + text.size());
+        for (int i = 0; i < code.mc(); ++i)
+        {
+            const auto &a = H.row_neighbor()[i];
+            const auto &b = code.H().row_neighbor()[i];
+            if (!std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto &x, const auto &y) { return x.nodeIndex == y.nodeIndex; }))
+            {
+                throw std::runtime_error("failed: alist import");
+            }
+        }
+
+        // QC base matrix and its expansion
+        std::string base = "6 3 7\n"
+                           "0 -1 3 1 0 -1\n"
+                           "2 4 -1 -1 0 0\n"
+                           "-1 6 5 0 -1 0\n";
+        ldpc::qc_matrix qc;
+        qc.parse(base.data(), base.data() + base.size());
+        auto Hqc = qc.expand();
+        if (Hqc.num_rows() != 21 || Hqc.num_cols() != 42 || Hqc.nz_entry().size() != qc.nnz())
+        {
+            throw std::runtime_error("failed: qc expansion dimensions");
+        }
+
+        // block (0, 2) with shift 3: row 1 holds column 2 * 7 + 4
+        const auto &row1 = Hqc.row_neighbor()[1];
+        if (std::none_of(row1.begin(), row1.end(), [](const ldpc::node &x) { return x.nodeIndex == 18; }))
+        {
+            throw std::runtime_error("failed: qc expansion shift");
+        }
+
+        ldpc::vec_bits_t c(qc.num_cols());
+        for (auto &x : c)
+        {
+            x = rand() % 2;
+        }
+
+        // the cache of a QC code keeps the base matrix only and expands it again
+        const std::string qcFile = "qc_import_test.qc";
+        std::ofstream(qcFile) << base;
+        ldpc::ldpc_code parsed(qcFile, "", ".");
+        ldpc::ldpc_code cached(qcFile, "", ".");
+        std::remove(qcFile.c_str());
+        std::remove(("./" + qcFile + ".cache").c_str());
+        if (!cached.is_qc() || cached.qc().exponents() != qc.exponents() || cached.nnz() != parsed.nnz() ||
+            cached.H().multiply_right(c) != Hqc.multiply_right(c))
+        {
+            throw std::runtime_error("failed: qc cache");
+        }
+
+        std::cout << "passed: alist & qc import" << std::endl;
+    }
+
+    void nr_codes()
+    {
+        if (ldpc::nr_base_graph::lifting_sizes().size() != 51 || ldpc::nr_base_graph::lifting_set(384) != 1 ||
+            ldpc::nr_base_graph::lifting_set(208) != 6 || ldpc::nr_base_graph::lifting_size(1, 8448) != 384)
+        {
+            throw std::runtime_error("failed: nr lifting sizes");
+        }
+
+        bool rejected = false;
+        try
+        {
+            ldpc::nr_base_graph::lifting_set(1);
+        }
+        catch (std::exception &e)
+        {
+            rejected = true;
+        }
+        if (!rejected)
+        {
+            throw std::runtime_error("failed: nr lifting size 1");
+        }
+
+        // BG2 shaped base graph, random shifts with the NR core and extension
+        std::mt19937 rng(7);
+        ldpc::mat_int V(42, ldpc::vec_int(52, -1));
+        for (int i = 0; i < 42; ++i)
+        {
+            const int cols = (i < 4) ? 10 : 14;
+            const int weight = (i < 4) ? 8 : 4;
+            for (int k = 0; k < weight; ++k)
+                V[i][rng() % cols] = rng() % 384;
+            if (i >= 4)
+                V[i][10 + i] = 0;
+        }
+        int core[4][4] = {{1, 0, -1, -1}, {-1, 0, 0, -1}, {0, -1, 0, 0}, {1, -1, -1, 0}};
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+                V[i][10 + j] = core[i][j];
+        }
+        ldpc::nr_base_graph bg(2, {V});
+
+        // the same table as shift table file, block (0, 0) with V of its own per lifting set
+        const std::string tableFile = "nr_table_test.txt";
+        const int V00[8] = {250, 307, 73, 223, 211, 294, 0, 135};
+        {
+            std::ofstream out(tableFile);
+            for (int i = 0; i < 42; ++i)
+            {
+                for (int j = 0; j < 52; ++j)
+                {
+                    if (V[i][j] < 0 && !(i == 0 && j == 0))
+                        continue;
+                    out << i << " " << j;
+                    for (int k = 0; k < 8; ++k)
+                        out << " " << ((i == 0 && j == 0) ? V00[k] : V[i][j]);
+                    out << "\n";
+                }
+            }
+        }
+        ldpc::nr_base_graph bgFile(2, tableFile);
+        std::remove(tableFile.c_str());
+
+        // known answers: the shift is V mod Z of the lifting set of Z,
+        // and row r of the block holds column (r + shift) mod Z
+        struct known
+        {
+            int Z, shift;
+        };
+        for (const auto &ka : {known{256, 250}, known{384, 307}, known{20, 13}, known{7, 6}, known{36, 31}, known{22, 8}, known{104, 0}, known{15, 0}})
+        {
+            const auto lifted = bgFile.lift(ka.Z);
+            const auto H = lifted.expand();
+            const auto &row = H.row_neighbor()[ka.Z - 1];
+            if (lifted.exponents()[0][0] != ka.shift || lifted.exponents()[0][10] != V[0][10] % ka.Z ||
+                row.empty() || row.front().nodeIndex != (ka.Z - 1 + ka.shift) % ka.Z)
+            {
+                throw std::runtime_error("failed: nr shift table file");
+            }
+        }
+
+        ldpc::decoder_param param;
+
+        struct config
+        {
+            int Z, filler, E, rv;
+        };
+        for (const auto &cfg : {config{16, 0, 0, 0}, config{52, 40, 700, 0}, config{104, 100, 4000, 2}, config{7, 3, 200, 3}})
+        {
+            auto code = std::make_shared<ldpc::ldpc_code>(bg.code(cfg.Z, cfg.filler, cfg.E, cfg.rv));
+            const int E = cfg.E > 0 ? cfg.E : 50 * cfg.Z - cfg.filler;
+            if (!code->is_qc() || code->nct() != E || static_cast<int>(code->shorten().size()) != cfg.filler ||
+                code->kc() != 10 * cfg.Z || !code->has_encoder())
+            {
+                throw std::runtime_error("failed: nr rate matching");
+            }
+
+            ldpc::vec_bits_t u(code->kc()), c(code->nc());
+            for (auto &x : u)
+            {
+                x = rand() % 2;
+            }
+            code->encode(u, c);
+            auto s = code->H().multiply_right(c);
+            if (std::any_of(s.begin(), s.end(), [](const ldpc::bits_t &x) { return x.value != 0; }) ||
+                std::any_of(code->shorten().begin(), code->shorten().end(), [&c](int i) { return c[i].value != 0; }))
+            {
+                throw std::runtime_error("failed: nr encoding");
+            }
+
+            // noiseless transmission of the rate-matched bits
+            ldpc::vec_double_t llr(code->nc(), 99999.9);
+            for (auto p : code->puncture())
+            {
+                llr[p] = 0.0;
+            }
+            for (auto i : code->bit_pos())
+            {
+                llr[i] = 4.0 * (1 - 2 * c[i].value);
+            }
+
+            ldpc::ldpc_decoder decoder(code, param);
+            decoder.set_llr_in(llr);
+            decoder.decode();
+            if (decoder.estimate() != c)
+            {
+                throw std::runtime_error("failed: nr decoding");
+            }
+        }
+
+        // the CRC covers the transmitted information bits, the filler bits stay zero,
+        // so a noiseless frame terminates early on its CRC
+        auto fillerCode = std::make_shared<ldpc::ldpc_code>(bg.code(52, 40));
+        ldpc::decoder_param crcParam;
+        crcParam.crcPoly = 0x1864CFB;
+        ldpc::channel_awgn ch(fillerCode, crcParam, 1, 100.);
+        ch.encode_and_map();
+        ch.simulate();
+        ch.calculate_llrs();
+        const auto infoTx = fillerCode->info_tx();
+        if (static_cast<int>(infoTx.size()) != fillerCode->kc() - 40 || !ldpc::crc(crcParam.crcPoly).check(ch.infoword(), infoTx) ||
+            std::any_of(ch.infoword().end() - 40, ch.infoword().end(), [](const ldpc::bits_t &x) { return x.value != 0; }) ||
+            ch.decode() >= static_cast<int>(crcParam.iterations) || ch.estimate() != ch.codeword())
+        {
+            throw std::runtime_error("failed: nr crc with filler bits");
+        }
+
+        std::cout << "passed: nr base graph codes" << std::endl;
+    }
+
+    void peg_construction()
+    {
+        // two columns sharing two rows form a 4-cycle
+        auto has_4_cycle = [](const ldpc::sparse_csr<ldpc::bits_t> &H) {
+            std::unordered_set<ldpc::u64> pairs;
+            for (const auto &row : H.row_neighbor())
+            {
+                for (std::size_t a = 0; a < row.size(); ++a)
+                {
+                    for (std::size_t b = a + 1; b < row.size(); ++b)
+                    {
+                        auto key = (static_cast<ldpc::u64>(row[a].nodeIndex) << 32) | row[b].nodeIndex;
+                        if (!pairs.insert(key).second)
+                            return true;
+                    }
+                }
+            }
+            return false;
+        };
+
+        ldpc::peg_param param;
+        param.seed = 1;
+        param.maxDepth = 0;
+        param.maxReach = 0;
+        param.ace = false;
+
+        auto degrees = ldpc::degree_sequence(1000, {{3, 1.0}});
+        for (auto maxReach : {0u, 64u})
+        {
+            param.maxReach = maxReach;
+            auto H = ldpc::peg(500, degrees, param);
+            for (int j = 0; j < H.num_cols(); ++j)
+            {
+                if (H.col_neighbor()[j].size() != 3)
+                    throw std::runtime_error("failed: peg variable degrees");
+            }
+            if (has_4_cycle(H))
+                throw std::runtime_error("failed: peg 4-cycle");
+        }
+
+        // irregular with ACE, encoded from H in memory
+        param.maxReach = 0;
+        param.ace = true;
+        degrees = ldpc::degree_sequence(1000, {{2, 0.4}, {3, 0.4}, {6, 0.2}});
+        if (std::count(degrees.begin(), degrees.end(), 2) != 400 || degrees.back() != 6)
+            throw std::runtime_error("failed: degree sequence");
+
+        ldpc::ldpc_code code(ldpc::peg(500, degrees, param));
+        if (has_4_cycle(code.H()) || !code.has_encoder())
+            throw std::runtime_error("failed: ace-peg code");
+
+        ldpc::vec_bits_t u(code.kc()), c(code.nc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        code.encode(u, c);
+        auto s = code.H().multiply_right(c);
+        if (std::any_of(s.begin(), s.end(), [](const ldpc::bits_t &x) { return x.value != 0; }))
+            throw std::runtime_error("failed: ace-peg encoding");
+
+        // QC-PEG, one circulant per base edge
+        param.ace = false;
+        auto qc = ldpc::qc_peg(6, ldpc::vec_int(12, 3), 31, param);
+        ldpc::ldpc_code qcCode(qc);
+        for (int j = 0; j < 12; ++j)
+        {
+            int d = 0;
+            for (int i = 0; i < 6; ++i)
+                d += (qc.exponents()[i][j] >= 0);
+            if (d != 3)
+                throw std::runtime_error("failed: qc-peg base degrees");
+        }
+        if (!qcCode.is_qc() || qcCode.nnz() != 12 * 3 * 31 || has_4_cycle(qcCode.H()))
+            throw std::runtime_error("failed: qc-peg code");
+
+        std::cout << "passed: peg construction" << std::endl;
+    }
+
+    void cycle_analysis(const ldpc::ldpc_code &code)
+    {
+        // small random H, every closed walk without repeated nodes from every variable
+        std::mt19937 rng(3);
+        std::vector<ldpc::edge<ldpc::bits_t>> edges;
+        for (int i = 0; i < 12; ++i)
+        {
+            for (int j = 0; j < 24; ++j)
+            {
+                if (rng() % 5 == 0)
+                    edges.push_back(ldpc::edge<ldpc::bits_t>({i, j, 1}));
+            }
+        }
+        ldpc::sparse_csr<ldpc::bits_t> H(12, 24, edges);
+
+        std::vector<ldpc::u64> walks(3, 0);
+        ldpc::vec_int shortest(24, 0);
+        std::vector<bool> onPath(36, false);
+        std::function<void(int, int, int)> walk = [&](int start, int x, int numChecks) {
+            for (const auto &c : H.col_neighbor()[x])
+            {
+                if (onPath[24 + c.nodeIndex])
+                    continue;
+                onPath[24 + c.nodeIndex] = true;
+                for (const auto &y : H.row_neighbor()[c.nodeIndex])
+                {
+                    if (y.nodeIndex == x)
+                        continue;
+                    if (y.nodeIndex == start && numChecks >= 1)
+                    {
+                        ++walks[numChecks - 1];
+                        if (shortest[start] == 0 || 2 * (numChecks + 1) < shortest[start])
+                            shortest[start] = 2 * (numChecks + 1);
+                    }
+                    else if (!onPath[y.nodeIndex] && numChecks < 3)
+                    {
+                        onPath[y.nodeIndex] = true;
+                        walk(start, y.nodeIndex, numChecks + 1);
+                        onPath[y.nodeIndex] = false;
+                    }
+                }
+                onPath[24 + c.nodeIndex] = false;
+            }
+        };
+        for (int v = 0; v < 24; ++v)
+        {
+            onPath[v] = true;
+            walk(v, v, 0);
+            onPath[v] = false;
+        }
+
+        // a cycle of length 2L is walked from each of its L variables in both directions
+        auto spectrum = ldpc::analyze_cycles(H);
+        for (int k = 0; k < 3; ++k)
+        {
+            if (spectrum.cycles[k] * 2 * (k + 2) != walks[k])
+                throw std::runtime_error("failed: cycle count");
+        }
+        for (int v = 0; v < 24; ++v)
+        {
+            if (shortest[v] > 0 && spectrum.varGirth[v] != shortest[v])
+                throw std::runtime_error("failed: local girth");
+            if (shortest[v] == 0 && spectrum.varGirth[v] > 0 && spectrum.varGirth[v] <= 8)
+                throw std::runtime_error("failed: local girth");
+        }
+        if (spectrum.girth != *std::min_element(shortest.begin(), shortest.end(), [](int a, int b) { return a > 0 && (b == 0 || a < b); }))
+            throw std::runtime_error("failed: girth");
+
+        std::cout << ldpc::analyze_cycles(code.H());
+        std::cout << "passed: cycle analysis" << std::endl;
+    }
+
+    void min_distance(const ldpc::ldpc_code &code)
+    {
+        ldpc::distance_param param;
+        param.seed = 5;
+        param.iterations = 10;
+        param.p = 2;
+
+        // Hamming code, seven codewords of weight 3
+        std::vector<ldpc::edge<ldpc::bits_t>> edges;
+        const char *rows[] = {"1010101", "0110011", "0001111"};
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 7; ++j)
+            {
+                if (rows[i][j] == '1')
+                    edges.push_back(ldpc::edge<ldpc::bits_t>({i, j, 1}));
+            }
+        }
+        auto hamming = ldpc::estimate_min_distance(ldpc::sparse_csr<ldpc::bits_t>(3, 7, edges), param);
+        if (hamming.dmin != 3 || hamming.multiplicity != 7)
+            throw std::runtime_error("failed: hamming code distance");
+
+        auto dist = ldpc::estimate_min_distance(code.H(), param);
+        if (dist.dmin < 1 || dist.multiplicity != dist.codewords.size())
+            throw std::runtime_error("failed: minimum distance estimate");
+
+        for (const auto &support : dist.codewords)
+        {
+            ldpc::vec_bits_t c(code.nc(), 0);
+            for (auto i : support)
+                c[i] = 1;
+            auto s = code.H().multiply_right(c);
+            if (static_cast<int>(support.size()) != dist.dmin || std::any_of(s.begin(), s.end(), [](const ldpc::bits_t &x) { return x.value != 0; }))
+                throw std::runtime_error("failed: low-weight codeword");
+        }
+
+        std::cout << "Minimum distance (upper bound) : " << dist.dmin << ", multiplicity (found) : " << dist.multiplicity << std::endl;
+        std::cout << "passed: minimum distance estimate" << std::endl;
+    }
+
+    void trapping_sets()
+    {
+        // (3, 6)-regular, the test code has no small sets through its degree-15 bits
+        ldpc::peg_param pegParam;
+        pegParam.seed = 3;
+        pegParam.maxDepth = 0;
+        pegParam.maxReach = 0;
+        pegParam.ace = false;
+        ldpc::ldpc_code code(ldpc::peg(48, ldpc::vec_int(96, 3), pegParam));
+
+        ldpc::trapping_param param;
+        param.maxA = 6;
+        param.maxB = 3;
+        param.cycleLength = 8;
+        param.slack = 2;
+
+        auto sets = ldpc::enumerate_trapping_sets(code, param);
+        if (sets.empty())
+            throw std::runtime_error("failed: no trapping sets found");
+
+        // recount (a, b) from the induced subgraph
+        std::set<ldpc::vec_int> distinct;
+        for (const auto &s : sets)
+        {
+            std::map<int, int> degree;
+            for (auto v : s.vars)
+            {
+                for (const auto &c : code.var_neighbor()[v])
+                    ++degree[c.nodeIndex];
+            }
+
+            int b = 0;
+            bool elementary = true;
+            for (const auto &d : degree)
+            {
+                b += (d.second == 1);
+                elementary = elementary && (d.second <= 2);
+            }
+
+            if (!elementary || s.a != static_cast<int>(s.vars.size()) || s.b != b || s.a > 6 || s.b > 3 || !distinct.insert(s.vars).second)
+                throw std::runtime_error("failed: trapping set");
+        }
+
+        // seed cycles longer than 2 maxA are skipped, not reported
+        param.maxA = 3;
+        param.cycleLength = 12;
+        for (const auto &s : ldpc::enumerate_trapping_sets(code, param))
+        {
+            if (s.a > 3)
+                throw std::runtime_error("failed: trapping set above maxA");
+        }
+
+        std::cout << "Trapping sets : " << sets.size() << ", smallest (" << sets.front().a << ", " << sets.front().b << ")" << std::endl;
+        std::cout << "passed: trapping sets" << std::endl;
+    }
+
+    void density_evolution()
+    {
+        // PEG code with degree-3 variables, the check degrees vary
+        ldpc::peg_param pegParam;
+        pegParam.seed = 3;
+        pegParam.maxDepth = 0;
+        pegParam.maxReach = 0;
+        pegParam.ace = false;
+        ldpc::ldpc_code code(ldpc::peg(48, ldpc::vec_int(96, 3), pegParam));
+
+        auto peg = ldpc::degree_distribution_of(code);
+        double checks = 0, rhoSum = 0;
+        for (ldpc::u64 j = 1; j < peg.rho.size(); ++j)
+        {
+            checks += peg.rho[j] / j * code.nnz_graph();
+            rhoSum += peg.rho[j];
+        }
+        if (peg.lambda != ldpc::vec_double_t({0, 0, 0, 1}) || !peg.lambdaPunctured.empty() || std::abs(rhoSum - 1) > 1e-12 || std::abs(checks - code.mc()) > 1e-9)
+            throw std::runtime_error("failed: degree distribution");
+
+        // (3, 6)-regular ensemble
+        ldpc::degree_distribution dist;
+        dist.lambda = {0, 0, 0, 1};
+        dist.rho = {0, 0, 0, 0, 0, 0, 1};
+
+        ldpc::de_param param;
+        param.iterations = 1000;
+        param.bins = 256;
+        param.maxLlr = 25;
+        param.targetError = 1e-6;
+        param.tolerance = 5e-4;
+
+        // known thresholds, SNR in dB with sigma^2 = 10^(-SNR/10)
+        struct
+        {
+            const char *method;
+            const char *decoding;
+            const char *channel;
+            double threshold;
+            double tolerance;
+        } cases[] = {
+            {"GA", "BP", "BEC", 0.4294, 0.002},
+            {"GA", "BP", "AWGN", 1.162, 0.02},
+            {"DDE", "BP", "AWGN", 1.102, 0.02},
+            {"DDE", "BP", "BSC", 0.084, 0.002},
+            {"DDE", "BP_MS", "AWGN", 1.70, 0.02},
+        };
+
+        for (const auto &c : cases)
+        {
+            param.method = c.method;
+            param.decoding = c.decoding;
+            param.channel = c.channel;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            const double threshold = ldpc::de_threshold(dist, param);
+            auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+            std::cout << "Threshold (" << c.method << ", " << c.decoding << ", " << c.channel << ") : " << threshold << " in " << time << "ms" << std::endl;
+            if (!(std::abs(threshold - c.threshold) <= c.tolerance))
+                throw std::runtime_error("failed: density evolution threshold");
+        }
+
+        // GA does not model min-sum
+        bool thrown = false;
+        try
+        {
+            param.method = "GA";
+            param.decoding = "BP_MS";
+            param.channel = "AWGN";
+            ldpc::de_error(dist, param, 2.0);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        if (!thrown)
+            throw std::runtime_error("failed: density evolution min-sum GA");
+
+        std::cout << "passed: density evolution" << std::endl;
+    }
+
+    void code_edits(const ldpc::ldpc_code &code)
+    {
+        // decoding graph, layers and degrees of the edited code against a rebuild
+        auto check = [](const ldpc::ldpc_code &edited) {
+            ldpc::ldpc_code ref(edited.H(), edited.puncture(), edited.shorten());
+
+            auto same = [](const std::vector<std::vector<ldpc::node>> &a, const std::vector<std::vector<ldpc::node>> &b) {
+                return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const auto &x, const auto &y) {
+                           return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), [](const ldpc::node &p, const ldpc::node &q) {
+                                      return p.nodeIndex == q.nodeIndex && p.edgeIndex == q.edgeIndex;
+                                  });
+                       });
+            };
+
+            auto pruned = edited.pruned_edges();
+            auto refPruned = ref.pruned_edges();
+            std::sort(pruned.begin(), pruned.end());
+            std::sort(refPruned.begin(), refPruned.end());
+
+            ldpc::vec_int layered, inGraph;
+            for (const auto &l : edited.layers())
+                layered.insert(layered.end(), l.begin(), l.end());
+            for (int i = 0; i < ref.mc(); ++i)
+            {
+                if (!ref.check_neighbor()[i].empty())
+                    inGraph.push_back(i);
+            }
+
+            if (!same(edited.check_neighbor(), ref.check_neighbor()) || !same(edited.var_neighbor(), ref.var_neighbor()) ||
+                pruned != refPruned || layered != inGraph || edited.nnz_graph() != ref.nnz_graph() || edited.max_degree() != ref.max_degree())
+                throw std::runtime_error("failed: incremental code update");
+        };
+
+        auto edited = std::make_shared<ldpc::ldpc_code>(code);
+
+        ldpc::decoder_param param;
+        param.iterations = 20;
+        ldpc::ldpc_decoder decoder(edited, param);
+
+        // moves, removals and additions, also of punctured bits
+        std::mt19937_64 rng(11);
+        for (int k = 0; k < 300; ++k)
+        {
+            const auto e = edited->H().nz_entry()[rng() % edited->nnz()];
+            const int row = rng() % edited->mc();
+            const int col = (k % 3 == 0) ? edited->puncture()[rng() % edited->puncture().size()] : static_cast<int>(rng() % edited->nc());
+            if (edited->H().find_entry(row, col) >= 0)
+                continue;
+
+            if (k % 4 == 0)
+                edited->remove_edge(e.rowIndex, e.colIndex);
+            else if (k % 4 == 1)
+                edited->add_edge(row, col);
+            else
+                edited->move_edge(e.rowIndex, e.colIndex, row, col);
+
+            if (k % 50 == 0)
+                check(*edited);
+        }
+        check(*edited);
+        if (edited->has_encoder() || edited->revision() == 0)
+            throw std::runtime_error("failed: encoder of the edited code");
+
+        // the attached decoder follows the edits, the all-zero word is a codeword
+        ldpc::vec_double_t llr(edited->nc(), 4.0);
+        for (auto p : edited->puncture())
+            llr[p] = 0.0;
+        decoder.set_llr_in(llr);
+        decoder.decode();
+        if (std::any_of(decoder.estimate().begin(), decoder.estimate().end(), [](const ldpc::bits_t &x) { return x.value != 0; }))
+            throw std::runtime_error("failed: decoding the edited code");
+
+        ldpc::ldpc_batch_decoder batch(edited, param, 2);
+        for (ldpc::u32 f = 0; f < batch.batch_size(); ++f)
+            batch.set_llr_in(f, llr);
+
+        // edit and evaluate loop of code design
+        auto start = std::chrono::high_resolution_clock::now();
+        const int numEdits = 2000;
+        for (int k = 0; k < numEdits; ++k)
+        {
+            const auto e = edited->H().nz_entry()[rng() % edited->nnz()];
+            const int row = rng() % edited->mc();
+            if (edited->H().find_entry(row, e.colIndex) < 0)
+                edited->move_edge(e.rowIndex, e.colIndex, row, e.colIndex);
+        }
+        auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        check(*edited);
+
+        // a further transmission and resuming start over on the edited graph
+        auto is_zero = [](const ldpc::vec_bits_t &c) {
+            return std::none_of(c.begin(), c.end(), [](const ldpc::bits_t &x) { return x.value != 0; });
+        };
+        decoder.combine_llr(ldpc::vec_double_t(edited->nc(), 1.0));
+        decoder.resume();
+        batch.decode(0, 0);
+        if (!is_zero(decoder.estimate()) || !is_zero(batch.estimate(0)) || !is_zero(batch.estimate(1)))
+            throw std::runtime_error("failed: resuming on the edited code");
+
+        // shifts of a QC code
+        ldpc::qc_matrix qc({{0, 1, 0, -1}, {2, -1, 3, 0}}, 5);
+        ldpc::ldpc_code qcCode(qc);
+        qcCode.set_shift(0, 1, 3);
+        qcCode.set_shift(1, 2, -1);
+        qcCode.set_shift(0, 3, 4);
+        check(qcCode);
+
+        std::set<std::pair<int, int>> entries, expanded;
+        for (const auto &e : qcCode.H().nz_entry())
+            entries.insert({e.rowIndex, e.colIndex});
+        const auto lifted = qcCode.qc().expand();
+        for (const auto &e : lifted.nz_entry())
+            expanded.insert({e.rowIndex, e.colIndex});
+        if (!qcCode.is_qc() || entries != expanded || qcCode.qc().exponents()[0][3] != 4)
+            throw std::runtime_error("failed: QC shift edit");
+
+        std::cout << "Edge moves : " << numEdits * 1e6 / std::max<long long>(time, 1) << " per second" << std::endl;
+        std::cout << "passed: code edits" << std::endl;
+    }
+
+    void decoding(const ldpc::ldpc_code &code)
+    {
+        auto ldpcCode = std::make_shared<ldpc::ldpc_code>(code);
+
+        ldpc::decoder_param param;
+
+        ldpc::vec_bits_t u(code.kc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        auto cw = code.G().multiply_left(u);
+
+        // noiseless channel, punctured bits erased and shortened bits certain
+        ldpc::vec_double_t llr(code.nc(), 99999.9);
+        for (auto p : code.puncture())
+        {
+            llr[p] = 0.0;
+        }
+        for (auto i : code.bit_pos())
+        {
+            llr[i] = 4.0 * (1 - 2 * cw[i].value);
+        }
+
+        // flooding and cache-blocked schedule
+        for (auto blockIterations : {0u, 2u})
+        {
+            param.blockIterations = blockIterations;
+            ldpc::ldpc_decoder decoder(ldpcCode, param);
+
+            decoder.set_llr_in(llr);
+            decoder.decode();
+
+            if (decoder.estimate() != cw)
+            {
+                throw std::runtime_error("failed: decoding noiseless codeword");
+            }
+        }
+
+        std::cout << "passed: decoding noiseless codeword" << std::endl;
+    }
+
+    void crc(const ldpc::ldpc_code &code)
+    {
+        // CRC24A, i.e. CRC-24/LTE-A with check value 0xCDE703
+        ldpc::crc crc24a(0x1864CFB);
+        ldpc::vec_bits_t msg;
+        for (auto c : std::string("123456789"))
+        {
+            for (int j = 7; j >= 0; --j)
+            {
+                msg.push_back((c >> j) & 1);
+            }
+        }
+
+        if (crc24a.checksum(msg, msg.size()) != 0xCDE703)
+        {
+            throw std::runtime_error("failed: crc check value");
+        }
+
+        // CRC-aided early termination on a noiseless codeword
+        ldpc::vec_bits_t u(code.kc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        crc24a.append(u);
+        if (!crc24a.check(u))
+        {
+            throw std::runtime_error("failed: crc append");
+        }
+        auto cw = code.G().multiply_left(u);
+
+        ldpc::decoder_param param;
+        param.crcPoly = 0x1864CFB;
+        ldpc::ldpc_decoder decoder(std::make_shared<ldpc::ldpc_code>(code), param);
+
+        ldpc::vec_double_t llr(code.nc(), 0.0);
+        for (auto i : code.bit_pos())
+        {
+            llr[i] = 4.0 * (1 - 2 * cw[i].value);
+        }
+
+        decoder.set_llr_in(llr);
+        decoder.decode();
+
+        if (decoder.estimate() != cw)
+        {
+            throw std::runtime_error("failed: crc-aided decoding");
+        }
+
+        // only the information bits are received, the CRC passes before the
+        // other bits converge and the output LLRs follow the re-encoded codeword
+        std::vector<bool> isInfo(code.nc(), false);
+        for (auto i : code.info_pos())
+        {
+            isInfo[i] = true;
+        }
+        for (int i = 0; i < code.nc(); ++i)
+        {
+            llr[i] = isInfo[i] ? 4.0 * (1 - 2 * cw[i].value) : 0.0;
+        }
+
+        for (auto blockIterations : {0u, 1u})
+        {
+            param.blockIterations = blockIterations;
+            decoder.set_param(param);
+            decoder.set_llr_in(llr);
+            decoder.decode();
+            for (int i = 0; i < code.nc(); ++i)
+            {
+                if ((decoder.llr_out()[i] <= 0) != decoder.estimate()[i].value || decoder.estimate()[i] != cw[i])
+                {
+                    throw std::runtime_error("failed: crc-aided decoding output LLR");
+                }
+            }
+        }
+
+        std::cout << "passed: crc" << std::endl;
+    }
+
+    void weighted_min_sum(const ldpc::ldpc_code &code, const std::string &weightFile)
+    {
+        auto ldpcCode = std::make_shared<ldpc::ldpc_code>(code);
+        ldpc::cn_weights weights(weightFile, ldpcCode);
+
+        // first check of degree 3, edges 0 and 1 belong to check 0
+        int w3 = 0;
+        while (code.check_neighbor()[w3].size() != 3)
+        {
+            ++w3;
+        }
+        if (weights.mode(0) != ldpc::cn_weights::DEGREE || weights.weight(0, w3, 0) != 0.7 ||
+            weights.mode(1) != ldpc::cn_weights::CHECK || weights.weight(1, 5, 0) != 0.6 || weights.weight(1, 4, 0) != 0.8 ||
+            weights.mode(2) != ldpc::cn_weights::EDGE || weights.weight(2, 0, 0) != 0.5 || weights.weight(2, 0, 1) != 0.8 ||
+            weights.weight(50, 0, 0) != 0.5)
+        {
+            throw std::runtime_error("failed: reading cn weights");
+        }
+
+        ldpc::decoder_param param;
+        param.type = "BP_WMS";
+        param.weightFile = weightFile.c_str();
+        ldpc::ldpc_decoder decoder(ldpcCode, param);
+
+        ldpc::vec_bits_t u(code.kc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        auto cw = code.G().multiply_left(u);
+
+        ldpc::vec_double_t llr(code.nc(), 0.0);
+        for (auto i : code.bit_pos())
+        {
+            llr[i] = 4.0 * (1 - 2 * cw[i].value);
+        }
+
+        decoder.set_llr_in(llr);
+        decoder.decode();
+
+        if (decoder.estimate() != cw)
+        {
+            throw std::runtime_error("failed: weighted min-sum decoding");
+        }
+
+        // an edit reloads the weights from the decoder's own copy of the
+        // path, the string given in the parameters is gone by then
+        {
+            auto path = std::make_unique<std::string>(weightFile);
+            param.weightFile = path->c_str();
+            ldpc::ldpc_decoder edited(ldpcCode, param);
+            path.reset();
+
+            // the last edge keeps its index, as do the weights of the file
+            const auto e = ldpcCode->H().nz_entry().back();
+            ldpcCode->remove_edge(e.rowIndex, e.colIndex);
+            ldpcCode->add_edge(e.rowIndex, e.colIndex);
+            edited.set_llr_in(llr);
+            edited.decode();
+            if (edited.estimate() != cw)
+            {
+                throw std::runtime_error("failed: weighted min-sum after an edit");
+            }
+        }
+
+        std::cout << "passed: weighted min-sum" << std::endl;
+    }
+
+    void lut_decoding(const ldpc::ldpc_code &code, const std::string &tableFile)
+    {
+        ldpc::decoder_param param;
+        param.type = "LUT";
+        param.tableFile = tableFile.c_str();
+        ldpc::ldpc_decoder decoder(std::make_shared<ldpc::ldpc_code>(code), param);
+
+        ldpc::vec_bits_t u(code.kc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        auto cw = code.G().multiply_left(u);
+
+        // noiseless channel with a few weak and flipped bits
+        ldpc::vec_double_t llr(code.nc(), 0.0);
+        for (auto i : code.bit_pos())
+        {
+            llr[i] = ((i % 97 == 0) ? -0.5 : 4.0) * (1 - 2 * cw[i].value);
+        }
+
+        decoder.set_llr_in(llr);
+        decoder.decode();
+
+        if (decoder.estimate() != cw)
+        {
+            throw std::runtime_error("failed: lookup-table decoding");
+        }
+
+        // only the information bits are received, the CRC ends the first
+        // iteration and the frame is re-encoded
+        ldpc::crc crc24a(0x1864CFB);
+        crc24a.append(u);
+        cw = code.G().multiply_left(u);
+        std::vector<bool> isInfo(code.nc(), false);
+        for (auto i : code.info_pos())
+        {
+            isInfo[i] = true;
+        }
+        for (int i = 0; i < code.nc(); ++i)
+        {
+            llr[i] = isInfo[i] ? 4.0 * (1 - 2 * cw[i].value) : 0.0;
+        }
+
+        param.crcPoly = 0x1864CFB;
+        decoder.set_param(param);
+        decoder.set_llr_in(llr);
+        if (decoder.decode() != 0 || decoder.estimate() != cw)
+        {
+            throw std::runtime_error("failed: lookup-table crc termination");
+        }
+        for (int i = 0; i < code.nc(); ++i)
+        {
+            if ((decoder.llr_out()[i] <= 0) != static_cast<bool>(cw[i].value))
+            {
+                throw std::runtime_error("failed: lookup-table crc output llr");
+            }
+        }
+
+        std::cout << "passed: lookup-table decoding" << std::endl;
+    }
+
+    void cascaded_decoding(const ldpc::ldpc_code &code)
+    {
+        ldpc::decoder_param param;
+        param.type = "BF,BP_OMS,BP";
+
+        ldpc::vec_bits_t u(code.kc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        auto cw = code.G().multiply_left(u);
+
+        // noiseless channel with a few weak and flipped bits
+        ldpc::vec_double_t llr(code.nc(), 0.0);
+        for (auto i : code.bit_pos())
+        {
+            llr[i] = ((i % 97 == 0) ? -0.5 : 4.0) * (1 - 2 * cw[i].value);
+        }
+
+        for (auto warmStart : {false, true})
+        {
+            param.warmStart = warmStart;
+            ldpc::ldpc_decoder decoder(std::make_shared<ldpc::ldpc_code>(code), param);
+
+            decoder.set_llr_in(llr);
+            decoder.decode();
+
+            if (decoder.stages().size() != 3 || decoder.stage() >= 3 || decoder.estimate() != cw)
+            {
+                throw std::runtime_error("failed: cascaded decoding");
+            }
+        }
+
+        std::cout << "passed: cascaded decoding" << std::endl;
+    }
+
+    void harq_decoding(const ldpc::ldpc_code &code)
+    {
+        ldpc::decoder_param param;
+        param.iterations = 10;
+
+        ldpc::vec_bits_t u(code.kc());
+        for (auto &x : u)
+        {
+            x = rand() % 2;
+        }
+        auto cw = code.G().multiply_left(u);
+
+        // weak first transmission with flipped bits, punctured bits erased
+        ldpc::vec_double_t llr(code.nc(), 0.0);
+        for (auto i : code.bit_pos())
+        {
+            llr[i] = ((i % 7 == 0) ? -0.2 : 0.2) * (1 - 2 * cw[i].value);
+        }
+
+        // retransmission of all bits, including the punctured ones
+        ldpc::vec_double_t llrTx(code.nc(), 0.0);
+        for (int i = 0; i < code.nc(); ++i)
+        {
+            llrTx[i] = 2.0 * (1 - 2 * cw[i].value);
+        }
+
+        for (auto blockIterations : {0u, 2u})
+        {
+            param.blockIterations = blockIterations;
+            ldpc::ldpc_decoder decoder(std::make_shared<ldpc::ldpc_code>(code), param);
+
+            decoder.set_llr_in(llr);
+            decoder.decode();
+            decoder.combine_llr(llrTx);
+            decoder.resume();
+
+            if (decoder.estimate() != cw)
+            {
+                throw std::runtime_error("failed: ir-harq decoding");
+            }
+        }
+
+        std::cout << "passed: ir-harq decoding" << std::endl;
+    }
+
+    void batch_decoding(const ldpc::ldpc_code &code)
+    {
+        ldpc::decoder_param param;
+
+        const ldpc::u32 batchSize = 4;
+        ldpc::ldpc_batch_decoder decoder(std::make_shared<ldpc::ldpc_code>(code), param, batchSize);
+
+        std::vector<ldpc::vec_bits_t> cw;
+        for (ldpc::u32 f = 0; f < batchSize; ++f)
+        {
+            ldpc::vec_bits_t u(code.kc());
+            for (auto &x : u)
+            {
+                x = rand() % 2;
+            }
+            cw.push_back(code.G().multiply_left(u));
+
+            // noiseless channel with a few weak and flipped bits
+            ldpc::vec_double_t llr(code.nc(), 0.0);
+            for (auto i : code.bit_pos())
+            {
+                llr[i] = ((i % (97 + f) == 0) ? -0.5 : 4.0) * (1 - 2 * cw[f][i].value);
+            }
+            decoder.set_llr_in(f, llr);
+        }
+
+        // no budget
+        auto report = decoder.decode(0, 0);
+        if (report.converged != batchSize || report.misses != 0)
+        {
+            throw std::runtime_error("failed: batch decoding");
+        }
+        for (ldpc::u32 f = 0; f < batchSize; ++f)
+        {
+            if (decoder.estimate(f) != cw[f])
+            {
+                throw std::runtime_error("failed: batch decoding");
+            }
+        }
+
+        // a budget of less iterations than frames misses the remaining ones
+        report = decoder.decode(0, 2);
+        if (report.totalIterations != 2 || report.misses < batchSize - 2)
+        {
+            throw std::runtime_error("failed: batch decoding iteration budget");
+        }
+
+        std::cout << "passed: batch decoding" << std::endl;
+    }
+
+    void nb_decoding(const ldpc::ldpc_code &code)
+    {
+        using gf16 = ldpc::gf2m<4>;
+
+        for (int a = 1; a < gf16::q; ++a)
+        {
+            if (gf16(a) * gf16(a).inverse() != gf16(1) || gf16(a) * (gf16(a) + gf16(3)) != gf16(a) * gf16(a) + gf16(a) * gf16(3))
+            {
+                throw std::runtime_error("failed: gf(16) arithmetic");
+            }
+        }
+
+        // coefficients outside 1..q-1 are rejected, not reduced
+        for (std::string entry : {"0 0 16\n", "0 0 0\n"})
+        {
+            bool rejected = false;
+            try
+            {
+                ldpc::sparse_csr<gf16> M;
+                M.parse(entry.data(), entry.data() + entry.size());
+            }
+            catch (std::exception &e)
+            {
+                rejected = true;
+            }
+            if (!rejected)
+            {
+                throw std::runtime_error("failed: gf(16) coefficient range");
+            }
+        }
+
+        // code structure of H with non-binary edge values
+        std::vector<ldpc::edge<gf16>> edges;
+        for (const auto &e : code.H().nz_entry())
+        {
+            edges.push_back(ldpc::edge<gf16>({e.rowIndex, e.colIndex, gf16(1 + (e.rowIndex * 7 + e.colIndex) % 15)}));
+        }
+        auto H = std::make_shared<ldpc::sparse_csr<gf16>>(code.mc(), code.nc(), edges);
+
+        ldpc::decoder_param param;
+        param.iterations = 20;
+
+        // all-zero codeword with a few symbols in favour of a wrong one,
+        // punctured symbols erased
+        ldpc::vec_double_t llr(static_cast<ldpc::u64>(code.nc()) * gf16::q, -2.0);
+        for (int v = 0; v < code.nc(); ++v)
+        {
+            llr[v * gf16::q] = 0.0;
+            if (v % 13 == 0)
+            {
+                llr[v * gf16::q + 1 + v % 15] = 0.5;
+            }
+        }
+        for (auto p : code.puncture())
+        {
+            std::fill(llr.begin() + p * gf16::q, llr.begin() + (p + 1) * gf16::q, 0.0);
+        }
+
+        for (auto type : {"BP", "EMS"})
+        {
+            param.type = type;
+            ldpc::ldpc_decoder_nb<gf16> decoder(H, param);
+            decoder.set_llr_in(llr);
+            decoder.decode();
+
+            if (decoder.estimate() != std::vector<gf16>(code.nc(), gf16(0)))
+            {
+                throw std::runtime_error(std::string("failed: non-binary decoding ") + type);
+            }
+        }
+
+        std::cout << "passed: non-binary decoding" << std::endl;
+    }
+
+    void sc_window_decoding()
+    {
+        // (3,6)-regular protograph coupled with w = 2, circulant size z
+        const int z = 64;
+        const int shifts[3][2] = {{0, 5}, {17, 41}, {29, 11}};
+        std::vector<ldpc::sparse_csr<ldpc::bits_t>> components;
+        for (int k = 0; k < 3; ++k)
+        {
+            std::vector<ldpc::edge<ldpc::bits_t>> edges;
+            for (int r = 0; r < z; ++r)
+            {
+                edges.push_back(ldpc::edge<ldpc::bits_t>({r, (r + shifts[k][0]) % z, 1}));
+                edges.push_back(ldpc::edge<ldpc::bits_t>({r, z + (r + shifts[k][1]) % z, 1}));
+            }
+            components.push_back(ldpc::sparse_csr<ldpc::bits_t>(z, 2 * z, edges));
+        }
+        auto code = std::make_shared<ldpc::sc_ldpc_code>(components, 20);
+
+        if (code->expand().nz_entry().size() != static_cast<std::size_t>(code->chain_length() * code->nnz_position()))
+        {
+            throw std::runtime_error("failed: sc-ldpc expansion");
+        }
+
+        ldpc::decoder_param param;
+        ldpc::sc_window_decoder decoder(code, param, 5);
+
+        // all-zero codeword over the biAWGN channel
+        const double sigma2 = 0.5;
+        std::mt19937_64 rng(0);
+        std::normal_distribution<double> noise(0., std::sqrt(sigma2));
+        ldpc::vec_double_t llr(code->nc());
+        for (auto &l : llr)
+        {
+            l = 2 * (1 + noise(rng)) / sigma2;
+        }
+
+        decoder.set_llr_in(llr);
+        decoder.decode();
+
+        for (auto c : decoder.estimate())
+        {
+            if (c != 0)
+            {
+                throw std::runtime_error("failed: sc-ldpc window decoding");
+            }
+        }
+
+        std::cout << "passed: sc-ldpc window decoding" << std::endl;
+    }
 } // namespace ldpc_tests